@@ -0,0 +1,239 @@
+#include "PointReader.h"
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t BufferSize = 1 << 16;
+constexpr std::size_t BlockPoints = 1 << 16;
+constexpr std::size_t MaxNumberLength = 64;
+
+bool parseNumber(const char* first, const char* last, double& value) {
+    if (first != last && *first == '+') ++first;   // from_chars не принимает '+'
+    auto [end, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && end == last && first != last;
+}
+
+// Буферизованный посимвольный ввод для текстовых форматов
+class TextReader : public PointReader {
+protected:
+    explicit TextReader(std::FILE* file) : PointReader(file), m_buffer(BufferSize) {}
+
+    int peek() {
+        if (m_pos == m_size && !refill()) return EOF;
+        return (unsigned char)m_buffer[m_pos];
+    }
+
+    int get() {
+        int c = peek();
+        if (c != EOF) ++m_pos;
+        return c;
+    }
+
+    // Символы числа с текущей позиции; false - слишком длинная лексема
+    bool token(char* text, std::size_t& length) {
+        length = 0;
+        for (;;) {
+            int c = peek();
+            if (!(std::isdigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) return true;
+            if (length == MaxNumberLength) return false;
+            text[length++] = (char)c;
+            ++m_pos;
+        }
+    }
+
+    std::size_t m_line{1};
+
+private:
+    bool refill() {
+        m_size = std::fread(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_pos = 0;
+        m_bytesRead += m_size;
+        if (m_size == 0 && std::ferror(m_file)) m_error = std::strerror(errno);
+        return m_size > 0;
+    }
+
+    std::vector<char> m_buffer;
+    std::size_t m_pos{0};
+    std::size_t m_size{0};
+};
+
+class CsvReader : public TextReader {
+public:
+    explicit CsvReader(std::FILE* file) : TextReader(file) {}
+
+    std::size_t read(std::vector<PlaneGeometry::Point>& out, std::size_t maxPoints) override {
+        std::size_t count = 0;
+        while (count < maxPoints && m_error.empty() && peek() != EOF) {
+            double values[2];
+            int numbers = 0;
+            bool text = false;
+            if (!readLine(values, numbers, text)) break;
+            ++m_line;
+            if (numbers == 0) continue;   // пустая строка, заголовок или комментарий
+            if (numbers < 2 || text) {
+                m_error = "line " + std::to_string(m_line - 1) + ": expected two numeric fields";
+                break;
+            }
+            out.push_back({values[0], values[1]});
+            ++count;
+        }
+        return m_error.empty() ? count : 0;
+    }
+
+private:
+    static bool isSeparator(int c) { return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r'; }
+
+    // Разбирает строку: числа из первых двух полей и признак нечислового поля среди них
+    bool readLine(double values[2], int& numbers, bool& text) {
+        if (peek() == '#') {
+            while (peek() != EOF && get() != '\n') {}
+            return true;
+        }
+        int fields = 0;
+        for (;;) {
+            int c = peek();
+            if (c == EOF) return true;
+            if (c == '\n') {
+                get();
+                return true;
+            }
+            if (isSeparator(c)) {
+                get();
+                continue;
+            }
+
+            char field[MaxNumberLength];
+            std::size_t length = 0;
+            bool numeric = token(field, length);
+            c = peek();
+            if (c != EOF && c != '\n' && !isSeparator(c)) {
+                numeric = false;
+                while (peek() != EOF && peek() != '\n' && !isSeparator(peek())) get();
+            }
+            ++fields;
+            if (fields > 2) continue;
+
+            double value;
+            if (numeric && parseNumber(field, field + length, value)) values[numbers++] = value;
+            else text = true;
+        }
+    }
+};
+
+class WktReader : public TextReader {
+public:
+    explicit WktReader(std::FILE* file) : TextReader(file) {}
+
+    // Числа между разделителями ',', '(' и ')' образуют кортеж координат;
+    // имена геометрий и EMPTY пропускаются
+    std::size_t read(std::vector<PlaneGeometry::Point>& out, std::size_t maxPoints) override {
+        std::size_t count = 0;
+        while (count < maxPoints && m_error.empty()) {
+            int c = peek();
+            if (c == EOF || c == ',' || c == '(' || c == ')') {
+                if (m_tupleSize == 2) {
+                    out.push_back({m_tuple[0], m_tuple[1]});
+                    ++count;
+                } else if (m_tupleSize != 0) {
+                    m_error = "line " + std::to_string(m_line) + ": only 2D coordinates are supported";
+                    break;
+                }
+                m_tupleSize = 0;
+                if (c == EOF) break;
+                get();
+            } else if (std::isdigit(c) || c == '-' || c == '+' || c == '.') {
+                char text[MaxNumberLength];
+                std::size_t length = 0;
+                double value;
+                if (!token(text, length) || !parseNumber(text, text + length, value)) {
+                    m_error = "line " + std::to_string(m_line) + ": malformed number";
+                    break;
+                }
+                if (m_tupleSize < 3) m_tuple[m_tupleSize] = value;
+                ++m_tupleSize;
+            } else {
+                if (get() == '\n') ++m_line;
+            }
+        }
+        return m_error.empty() ? count : 0;
+    }
+
+private:
+    double m_tuple[3]{};
+    int    m_tupleSize{0};
+};
+
+class BinaryReader : public PointReader {
+public:
+    explicit BinaryReader(std::FILE* file) : PointReader(file) {}
+
+    std::size_t read(std::vector<PlaneGeometry::Point>& out, std::size_t maxPoints) override {
+        m_block.resize(2 * maxPoints);
+        std::size_t values = std::fread(m_block.data(), sizeof(double), m_block.size(), m_file);
+        m_bytesRead += values * sizeof(double);
+        if (values < m_block.size() && std::ferror(m_file)) {
+            m_error = std::strerror(errno);
+            return 0;
+        }
+        if (values % 2 != 0) {
+            m_error = "truncated binary input: odd number of coordinates";
+            return 0;
+        }
+        for (std::size_t i = 0; i < values; i += 2) out.push_back({m_block[i], m_block[i + 1]});
+        return values / 2;
+    }
+
+private:
+    std::vector<double> m_block;
+};
+
+} // namespace
+
+std::optional<InputFormat> parseInputFormat(std::string_view name) {
+    if (name == "csv") return InputFormat::Csv;
+    if (name == "wkt") return InputFormat::Wkt;
+    if (name == "bin") return InputFormat::Binary;
+    return std::nullopt;
+}
+
+InputFormat inputFormatFromPath(std::string_view path) {
+    auto endsWith = [&](std::string_view suffix) {
+        return path.size() >= suffix.size() && path.substr(path.size() - suffix.size()) == suffix;
+    };
+    if (endsWith(".wkt")) return InputFormat::Wkt;
+    if (endsWith(".bin")) return InputFormat::Binary;
+    return InputFormat::Csv;
+}
+
+std::unique_ptr<PointReader> PointReader::open(const std::string& path, InputFormat format, std::string& error) {
+    std::FILE* file = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    switch (format) {
+    case InputFormat::Csv:    return std::make_unique<CsvReader>(file);
+    case InputFormat::Wkt:    return std::make_unique<WktReader>(file);
+    case InputFormat::Binary: return std::make_unique<BinaryReader>(file);
+    }
+    return nullptr;
+}
+
+PointReader::~PointReader() {
+    if (m_file && m_file != stdin) std::fclose(m_file);
+}
+
+bool readAllPoints(const std::string& path, InputFormat format,
+                   std::vector<PlaneGeometry::Point>& points, std::string& error) {
+    std::unique_ptr<PointReader> reader = PointReader::open(path, format, error);
+    if (!reader) return false;
+    while (reader->read(points, BlockPoints) > 0) {}
+    if (!reader->error().empty()) {
+        error = path + ": " + reader->error();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "PlaneGeometry/Geometry.h"
+
+// Потоковое чтение точек блоками фиксированного размера, без загрузки файла целиком.
+//   csv - по точке в строке, берутся первые два числа; строки без чисел (заголовок) пропускаются
+//   wkt - координаты из POINT/MULTIPOINT/LINESTRING/POLYGON/...; только 2D
+//   bin - подряд идущие пары double (x, y) в порядке байтов машины
+enum class InputFormat { Csv, Wkt, Binary };
+
+std::optional<InputFormat> parseInputFormat(std::string_view name);
+InputFormat inputFormatFromPath(std::string_view path);   // по расширению, по умолчанию csv
+
+class PointReader {
+public:
+    // "-" - стандартный ввод; nullptr и текст ошибки, если файл не открылся
+    static std::unique_ptr<PointReader> open(const std::string& path, InputFormat format, std::string& error);
+
+    virtual ~PointReader();
+
+    // Дописывает в out до maxPoints точек; 0 - ввод исчерпан или ошибка
+    virtual std::size_t read(std::vector<PlaneGeometry::Point>& out, std::size_t maxPoints) = 0;
+
+    const std::string& error() const { return m_error; }
+    std::size_t bytesRead() const { return m_bytesRead; }
+
+protected:
+    explicit PointReader(std::FILE* file) : m_file(file) {}
+
+    std::FILE*  m_file;
+    std::string m_error;
+    std::size_t m_bytesRead{0};
+};
+
+// Все точки файла; false и текст ошибки при неудаче
+bool readAllPoints(const std::string& path, InputFormat format,
+                   std::vector<PlaneGeometry::Point>& points, std::string& error);
@@ -0,0 +1,150 @@
+#include "ResultWriter.h"
+#include <charconv>
+
+std::optional<OutputFormat> parseOutputFormat(std::string_view name) {
+    if (name == "csv") return OutputFormat::Csv;
+    if (name == "wkt") return OutputFormat::Wkt;
+    return std::nullopt;
+}
+
+namespace {
+
+constexpr std::size_t FlushSize = 1 << 16;
+
+} // namespace
+
+ResultWriter::ResultWriter(std::FILE* file, OutputFormat format)
+    : m_file(file), m_format(format) {
+    m_buffer.reserve(FlushSize + 64);
+}
+
+ResultWriter::~ResultWriter() {
+    flush();
+}
+
+void ResultWriter::put(std::string_view text) {
+    m_buffer.append(text);
+    if (m_buffer.size() >= FlushSize) flush();
+}
+
+void ResultWriter::flush() {
+    if (m_buffer.empty()) return;
+    std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+    m_buffer.clear();
+}
+
+void ResultWriter::number(double value) {
+    // Кратчайшая запись, которая читается обратно в то же значение
+    char text[32];
+    auto [end, ec] = std::to_chars(text, text + sizeof(text), value);
+    put(std::string_view(text, end - text));
+}
+
+void ResultWriter::point(double x, double y, char separator) {
+    number(x);
+    put(separator);
+    number(y);
+}
+
+void ResultWriter::ring(const PlaneGeometry::Point* points, std::size_t count) {
+    // Кольцо WKT замыкается повтором первой вершины
+    put('(');
+    for (std::size_t i = 0; i <= count; ++i) {
+        if (i > 0) put(", ");
+        const PlaneGeometry::Point& p = points[i % count];
+        point(p.x, p.y, ' ');
+    }
+    put(')');
+}
+
+void ResultWriter::geometry(const PlaneGeometry::Polygon& polygon) {
+    // Оболочка из одной или двух точек - не многоугольник: кольцо WKT
+    // требует не меньше четырех позиций. Две совпавшие точки - тоже POINT
+    const bool single = polygon.size() == 1 ||
+        (polygon.size() == 2 && polygon[0].x == polygon[1].x && polygon[0].y == polygon[1].y);
+    if (single) {
+        put("POINT (");
+        point(polygon[0].x, polygon[0].y, ' ');
+        put(')');
+    } else if (polygon.size() == 2) {
+        put("LINESTRING (");
+        point(polygon[0].x, polygon[0].y, ' ');
+        put(", ");
+        point(polygon[1].x, polygon[1].y, ' ');
+        put(')');
+    } else {
+        put("POLYGON (");
+        ring(polygon.data(), polygon.size());
+        put(')');
+    }
+}
+
+void ResultWriter::writePolygons(const std::vector<PlaneGeometry::Polygon>& polygons) {
+    if (m_format == OutputFormat::Csv) {
+        for (std::size_t i = 0; i < polygons.size(); ++i) {
+            if (i > 0) put('\n');
+            for (const auto& p : polygons[i]) {
+                point(p.x, p.y, ',');
+                put('\n');
+            }
+        }
+        return;
+    }
+
+    std::vector<const PlaneGeometry::Polygon*> nonEmpty;
+    bool degenerate = false;
+    for (const auto& polygon : polygons) {
+        if (polygon.empty()) continue;
+        nonEmpty.push_back(&polygon);
+        degenerate |= polygon.size() < 3;
+    }
+    if (nonEmpty.empty()) {
+        put("POLYGON EMPTY\n");
+    } else if (nonEmpty.size() == 1) {
+        geometry(*nonEmpty[0]);
+        put('\n');
+    } else if (degenerate) {
+        put("GEOMETRYCOLLECTION (");
+        for (std::size_t i = 0; i < nonEmpty.size(); ++i) {
+            if (i > 0) put(",\n  ");
+            geometry(*nonEmpty[i]);
+        }
+        put(")\n");
+    } else {
+        put("MULTIPOLYGON (");
+        for (std::size_t i = 0; i < nonEmpty.size(); ++i) {
+            put(i > 0 ? ",\n  (" : "(");
+            ring(nonEmpty[i]->data(), nonEmpty[i]->size());
+            put(')');
+        }
+        put(")\n");
+    }
+}
+
+void ResultWriter::writeTriangles(const DelaunayMesh& mesh) {
+    if (m_format == OutputFormat::Csv) {
+        for (const auto& t : mesh.triangles) {
+            for (int i = 0; i < 3; ++i) {
+                if (i > 0) put(',');
+                point(mesh.vertices[t[i]].x, mesh.vertices[t[i]].y, ',');
+            }
+            put('\n');
+        }
+        return;
+    }
+
+    if (mesh.triangles.empty()) {
+        put("MULTIPOLYGON EMPTY\n");
+        return;
+    }
+    put("MULTIPOLYGON (");
+    for (std::size_t k = 0; k < mesh.triangles.size(); ++k) {
+        const auto& t = mesh.triangles[k];
+        PlaneGeometry::Point corners[3];
+        for (int i = 0; i < 3; ++i) corners[i] = {mesh.vertices[t[i]].x, mesh.vertices[t[i]].y};
+        put(k > 0 ? ",\n  (" : "(");
+        ring(corners, 3);
+        put(')');
+    }
+    put(")\n");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/Geometry.h"
+#include "PlaneGeometry/Geometry.h"
+
+// Вывод результата в csv (по вершине/треугольнику в строке) или wkt
+enum class OutputFormat { Csv, Wkt };
+
+std::optional<OutputFormat> parseOutputFormat(std::string_view name);
+
+class ResultWriter {
+public:
+    ResultWriter(std::FILE* file, OutputFormat format);
+    ~ResultWriter();
+
+    // csv: "x,y" по строкам, многоугольники разделены пустой строкой;
+    // wkt: POLYGON или MULTIPOLYGON; многоугольник из одной или двух вершин
+    // выводится как POINT или LINESTRING (в наборе - GEOMETRYCOLLECTION)
+    void writePolygons(const std::vector<PlaneGeometry::Polygon>& polygons);
+
+    // csv: "x1,y1,x2,y2,x3,y3" по строкам; wkt: MULTIPOLYGON из треугольников
+    void writeTriangles(const DelaunayMesh& mesh);
+
+    // Дописывает накопленный текст в файл. Деструктор тоже вызывает flush,
+    // поэтому писатель должен быть разрушен до закрытия файла
+    void flush();
+    bool ok() const { return !std::ferror(m_file); }
+
+private:
+    void put(std::string_view text);
+    void put(char c) { put(std::string_view(&c, 1)); }
+    void number(double value);
+    void point(double x, double y, char separator);
+    void ring(const PlaneGeometry::Point* points, std::size_t count);
+    void geometry(const PlaneGeometry::Polygon& polygon);
+
+    std::FILE*   m_file;
+    OutputFormat m_format;
+    std::string  m_buffer;
+};
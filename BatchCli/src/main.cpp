@@ -0,0 +1,346 @@
+#include "PointReader.h"
+#include "ResultWriter.h"
+#include "core/Geometry.h"
+#include "PlaneGeometry/Geometry.h"
+#include "PlaneGeometry/Predicates.h"
+#include "PlaneGeometry/StreamingHull.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Консольный запуск алгоритмов без GUI: точки и многоугольники читаются
+// из файлов, результат пишется в файл или stdout.
+
+namespace {
+
+const char* Usage =
+    "usage: GeometryCli <operation> [options] <input> [<clip>]\n"
+    "\n"
+    "operations:\n"
+    "  hull        convex hull of the input points\n"
+    "  delaunay    Delaunay triangulation of the input points\n"
+    "  intersect   input polygon clipped by the convex <clip> polygon\n"
+    "  difference  convex input polygon minus convex <clip> polygon as a set\n"
+    "              of disjoint convex parts\n"
+    "  union       union of two convex polygons as a set of disjoint convex parts\n"
+    "\n"
+    "options:\n"
+    "  --format csv|wkt|bin      input format (default: by file extension, csv)\n"
+    "  --output <path>           output file (default: stdout)\n"
+    "  --output-format csv|wkt   output format (default: csv)\n"
+    "  --threads <n>             hull: parallel hull on n threads;\n"
+    "                            delaunay: divide and conquer on n threads\n"
+    "                            (the triangulation does not depend on n)\n"
+    "  --no-cull                 hull: skip Akl-Toussaint interior point culling\n"
+    "  --hull chain|chan         hull: monotone chain or Chan's algorithm\n"
+    "                            (default: chain)\n"
+    "  --stream                  hull: one pass over the input keeping only the\n"
+    "                            running hull and a bounded candidate buffer\n"
+    "  --timings                 print per-stage timings to stderr\n"
+    "\n"
+    "Input '-' reads standard input.\n";
+
+enum class Operation { Hull, Delaunay, Intersect, Difference, Union };
+
+struct Options {
+    Operation operation{};
+    std::string input;
+    std::string clip;
+    std::optional<InputFormat> format;
+    std::string output;
+    OutputFormat outputFormat = OutputFormat::Csv;
+    unsigned threads = 0;     // 0 - один поток
+    bool timings = false;
+    bool cullInterior = true; // отсечение внутренних точек перед оболочкой
+    bool stream = false;      // оболочка без загрузки всего входа
+    PlaneGeometry::HullAlgorithm hullAlgorithm = PlaneGeometry::HullAlgorithm::MonotoneChain;
+};
+
+class StageTimer {
+public:
+    explicit StageTimer(bool enabled) : m_enabled(enabled) {}
+
+    void start() { m_start = Clock::now(); }
+
+    void report(const char* stage, const std::string& detail = {}) {
+        if (!m_enabled) return;
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+        std::fprintf(stderr, "%-10s %12.3f ms  %s\n", stage, ms, detail.c_str());
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    bool m_enabled;
+    Clock::time_point m_start;
+};
+
+std::optional<Operation> parseOperation(std::string_view name) {
+    if (name == "hull")       return Operation::Hull;
+    if (name == "delaunay")   return Operation::Delaunay;
+    if (name == "intersect")  return Operation::Intersect;
+    if (name == "difference") return Operation::Difference;
+    if (name == "union")      return Operation::Union;
+    return std::nullopt;
+}
+
+bool needsClip(Operation operation) {
+    return operation == Operation::Intersect || operation == Operation::Difference
+        || operation == Operation::Union;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    if (argc < 2) return false;
+    auto operation = parseOperation(argv[1]);
+    if (!operation) {
+        std::fprintf(stderr, "unknown operation: %s\n", argv[1]);
+        return false;
+    }
+    options.operation = *operation;
+
+    std::vector<std::string> positional;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--timings") {
+            options.timings = true;
+            continue;
+        }
+        if (arg == "--no-cull") {
+            options.cullInterior = false;
+            continue;
+        }
+        if (arg == "--stream") {
+            options.stream = true;
+            continue;
+        }
+        if (arg.size() < 2 || arg.substr(0, 2) != "--") {
+            positional.emplace_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", argv[i]);
+            return false;
+        }
+        std::string_view value = argv[++i];
+        if (arg == "--format") {
+            options.format = parseInputFormat(value);
+            if (!options.format) {
+                std::fprintf(stderr, "unknown input format: %s\n", argv[i]);
+                return false;
+            }
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--output-format") {
+            auto format = parseOutputFormat(value);
+            if (!format) {
+                std::fprintf(stderr, "unknown output format: %s\n", argv[i]);
+                return false;
+            }
+            options.outputFormat = *format;
+        } else if (arg == "--threads") {
+            options.threads = (unsigned)std::strtoul(argv[i], nullptr, 10);
+        } else if (arg == "--hull") {
+            if (value == "chain") options.hullAlgorithm = PlaneGeometry::HullAlgorithm::MonotoneChain;
+            else if (value == "chan") options.hullAlgorithm = PlaneGeometry::HullAlgorithm::Chan;
+            else {
+                std::fprintf(stderr, "unknown hull algorithm: %s\n", argv[i]);
+                return false;
+            }
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+
+    const std::size_t expected = needsClip(options.operation) ? 2 : 1;
+    if (positional.size() != expected) {
+        std::fprintf(stderr, "expected %zu input file(s)\n", expected);
+        return false;
+    }
+    options.input = positional[0];
+    if (expected == 2) options.clip = positional[1];
+    return true;
+}
+
+bool readPoints(const std::string& path, const Options& options, StageTimer& timer,
+                const char* stage, std::vector<PlaneGeometry::Point>& points) {
+    timer.start();
+    std::string error;
+    if (!readAllPoints(path, options.format.value_or(inputFormatFromPath(path)), points, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    timer.report(stage, std::to_string(points.size()) + " points");
+    return true;
+}
+
+// Оболочка без загрузки всего файла: точки читаются блоками и сразу
+// сливаются с текущей оболочкой
+bool streamHull(const std::string& path, const Options& options, const PlaneGeometry::HullOptions& hullOptions,
+                PlaneGeometry::Polygon& hull, std::string& detail) {
+    const std::size_t StreamBlockPoints = 1 << 16;
+    std::string error;
+    std::unique_ptr<PointReader> reader =
+        PointReader::open(path, options.format.value_or(inputFormatFromPath(path)), error);
+    if (!reader) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+
+    PlaneGeometry::StreamingHull streaming(hullOptions);
+    std::vector<PlaneGeometry::Point> block;
+    block.reserve(StreamBlockPoints);
+    for (;;) {
+        block.clear();
+        if (reader->read(block, StreamBlockPoints) == 0) break;
+        streaming.add(block.data(), block.size());
+    }
+    if (!reader->error().empty()) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), reader->error().c_str());
+        return false;
+    }
+    hull = streaming.hull();
+    detail = ", streamed " + std::to_string(streaming.pointsSeen()) + " points, rejected "
+           + std::to_string(streaming.pointsRejected()) + " on arrival";
+    return true;
+}
+
+// Вершины многоугольника из файла: без повтора первой вершины в конце, против часовой
+bool toConvexPolygon(PlaneGeometry::Polygon& polygon, const std::string& path) {
+    if (polygon.size() > 1 && polygon.front().x == polygon.back().x && polygon.front().y == polygon.back().y)
+        polygon.pop_back();
+
+    double area = 0;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        const auto& p = polygon[i];
+        const auto& q = polygon[(i + 1) % polygon.size()];
+        area += p.x*q.y - p.y*q.x;
+    }
+    if (area < 0) std::reverse(polygon.begin(), polygon.end());
+
+    const std::size_t n = polygon.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (PlaneGeometry::orient2d(polygon[i], polygon[(i + 1) % n], polygon[(i + 2) % n]) < 0) {
+            std::fprintf(stderr, "%s: polygon is not convex\n", path.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// Отсечение оставляет повторные вершины, когда вершина лежит на отсекающей прямой
+void removeRepeatedVertices(PlaneGeometry::Polygon& polygon) {
+    auto same = [](const PlaneGeometry::Point& a, const PlaneGeometry::Point& b) {
+        return a.x == b.x && a.y == b.y;
+    };
+    polygon.erase(std::unique(polygon.begin(), polygon.end(), same), polygon.end());
+    while (polygon.size() > 1 && same(polygon.front(), polygon.back())) polygon.pop_back();
+    if (polygon.size() < 3) polygon.clear();
+}
+
+int run(const Options& options) {
+    StageTimer timer(options.timings);
+
+    const bool stream = options.operation == Operation::Hull && options.stream;
+    std::vector<PlaneGeometry::Point> input, clip;
+    if (!stream && !readPoints(options.input, options, timer, "read", input)) return 1;
+    if (needsClip(options.operation)) {
+        if (!readPoints(options.clip, options, timer, "read clip", clip)) return 1;
+        if (options.operation != Operation::Intersect && !toConvexPolygon(input, options.input)) return 1;
+        if (!toConvexPolygon(clip, options.clip)) return 1;
+    }
+
+    std::vector<PlaneGeometry::Polygon> polygons;
+    DelaunayMesh mesh;
+    PlaneGeometry::HullStats hullStats;
+    std::string streamDetail;
+
+    timer.start();
+    switch (options.operation) {
+    case Operation::Hull: {
+        PlaneGeometry::HullOptions hullOptions;
+        hullOptions.cullInterior = options.cullInterior;
+        hullOptions.algorithm = options.hullAlgorithm;
+        hullOptions.threads = std::max(1u, options.threads);
+        if (stream) {
+            polygons.emplace_back();
+            if (!streamHull(options.input, options, hullOptions, polygons.back(), streamDetail)) return 1;
+            break;
+        }
+        polygons.push_back(PlaneGeometry::convexHull(input, hullOptions, &hullStats));
+        break;
+    }
+    case Operation::Delaunay: {
+        std::vector<Point> points;
+        points.reserve(input.size());
+        for (const auto& p : input) points.push_back({p.x, p.y});
+        std::vector<PlaneGeometry::Point>().swap(input);
+        // Всегда "разделяй и властвуй": у точек на одной окружности инкрементальный
+        // delaunayMesh может выбрать другие диагонали, и вывод зависел бы от --threads
+        mesh = Geometry::delaunayMeshParallel(points, std::max(1u, options.threads));
+        break;
+    }
+    case Operation::Intersect:
+        polygons.push_back(PlaneGeometry::intersectConvex(input, clip));
+        break;
+    case Operation::Difference:
+        polygons = PlaneGeometry::differenceConvexDecomposed(input, clip);
+        break;
+    case Operation::Union:
+        polygons = PlaneGeometry::unionConvexDecomposed(input, clip);
+        break;
+    }
+    if (needsClip(options.operation)) {
+        for (auto& polygon : polygons) removeRepeatedVertices(polygon);
+        polygons.erase(std::remove_if(polygons.begin(), polygons.end(),
+                                      [](const auto& polygon) { return polygon.empty(); }),
+                       polygons.end());
+    }
+    std::string detail = options.operation == Operation::Delaunay
+                         ? std::to_string(mesh.triangles.size()) + " triangles"
+                         : std::to_string(polygons.size()) + " polygon(s)";
+    if (stream)
+        detail += streamDetail;
+    else if (options.operation == Operation::Hull)
+        detail += ", culled " + std::to_string(hullStats.culled) + " of " + std::to_string(hullStats.input)
+                + (hullStats.algorithm == PlaneGeometry::HullAlgorithm::Chan ? ", Chan" : ", monotone chain");
+    timer.report("compute", detail);
+
+    timer.start();
+    std::FILE* file = options.output.empty() ? stdout : std::fopen(options.output.c_str(), "wb");
+    if (!file) {
+        std::perror(options.output.c_str());
+        return 1;
+    }
+    bool ok;
+    {
+        // Писатель разрушается до закрытия файла: его деструктор пишет в file
+        ResultWriter writer(file, options.outputFormat);
+        if (options.operation == Operation::Delaunay) writer.writeTriangles(mesh);
+        else writer.writePolygons(polygons);
+        writer.flush();
+        ok = writer.ok();
+    }
+    ok = std::fflush(file) == 0 && ok;
+    if (file != stdout) ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::fprintf(stderr, "failed to write output\n");
+        return 1;
+    }
+    timer.report("write");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fputs(Usage, stderr);
+        return 2;
+    }
+    return run(options);
+}
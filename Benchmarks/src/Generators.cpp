@@ -0,0 +1,105 @@
+#include "Generators.h"
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+constexpr double Extent = 1000.0;   // точки лежат в квадрате [0, Extent]^2
+
+struct NamedDistribution {
+    Distribution distribution;
+    std::string_view name;
+};
+
+constexpr NamedDistribution Names[] = {
+    {Distribution::UniformSquare,    "uniform_square"},
+    {Distribution::UniformDisk,      "uniform_disk"},
+    {Distribution::GaussianClusters, "gaussian_clusters"},
+    {Distribution::Circle,           "circle"},
+    {Distribution::IntegerGrid,      "integer_grid"},
+    {Distribution::NearlyCollinear,  "nearly_collinear"},
+};
+
+} // namespace
+
+const std::vector<Distribution>& allDistributions() {
+    static const std::vector<Distribution> distributions = [] {
+        std::vector<Distribution> result;
+        for (const auto& named : Names) result.push_back(named.distribution);
+        return result;
+    }();
+    return distributions;
+}
+
+std::string_view distributionName(Distribution distribution) {
+    for (const auto& named : Names) {
+        if (named.distribution == distribution) return named.name;
+    }
+    return "unknown";
+}
+
+std::optional<Distribution> parseDistribution(std::string_view name) {
+    for (const auto& named : Names) {
+        if (named.name == name) return named.distribution;
+    }
+    return std::nullopt;
+}
+
+std::vector<Point> generatePoints(Distribution distribution, std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Point> points;
+    points.reserve(n);
+
+    switch (distribution) {
+    case Distribution::UniformSquare:
+        for (std::size_t i = 0; i < n; ++i) points.push_back({unit(rng) * Extent, unit(rng) * Extent});
+        break;
+
+    case Distribution::UniformDisk:
+        for (std::size_t i = 0; i < n; ++i) {
+            double r = Extent / 2 * std::sqrt(unit(rng));
+            double a = 2 * std::numbers::pi * unit(rng);
+            points.push_back({Extent / 2 + r * std::cos(a), Extent / 2 + r * std::sin(a)});
+        }
+        break;
+
+    case Distribution::GaussianClusters: {
+        constexpr int Clusters = 10;
+        std::vector<Point> centers;
+        for (int i = 0; i < Clusters; ++i) centers.push_back({unit(rng) * Extent, unit(rng) * Extent});
+        std::normal_distribution<double> offset(0.0, Extent / 50);
+        std::uniform_int_distribution<int> pick(0, Clusters - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            const Point& c = centers[pick(rng)];
+            points.push_back({c.x + offset(rng), c.y + offset(rng)});
+        }
+        break;
+    }
+
+    case Distribution::Circle:
+        // Все точки на оболочке и почти на одной окружности - худший случай для обоих алгоритмов
+        for (std::size_t i = 0; i < n; ++i) {
+            double a = 2 * std::numbers::pi * unit(rng);
+            points.push_back({Extent / 2 + Extent / 2 * std::cos(a), Extent / 2 + Extent / 2 * std::sin(a)});
+        }
+        break;
+
+    case Distribution::IntegerGrid: {
+        // Много коллинеарных и коциркулярных четверок
+        std::size_t side = (std::size_t)std::ceil(std::sqrt((double)n));
+        for (std::size_t i = 0; i < n; ++i) points.push_back({(double)(i % side), (double)(i / side)});
+        break;
+    }
+
+    case Distribution::NearlyCollinear:
+        // Отклонение от прямой порядка ошибки округления
+        for (std::size_t i = 0; i < n; ++i) {
+            double x = unit(rng) * Extent;
+            points.push_back({x, 0.5 * x + (unit(rng) - 0.5) * 1e-9});
+        }
+        break;
+    }
+    return points;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "core/Geometry.h"
+
+// Стандартные распределения точек для замеров
+enum class Distribution {
+    UniformSquare,
+    UniformDisk,
+    GaussianClusters,
+    Circle,
+    IntegerGrid,
+    NearlyCollinear,
+};
+
+const std::vector<Distribution>& allDistributions();
+std::string_view distributionName(Distribution distribution);
+std::optional<Distribution> parseDistribution(std::string_view name);
+
+std::vector<Point> generatePoints(Distribution distribution, std::size_t n, std::uint64_t seed);
@@ -0,0 +1,53 @@
+#include "Memory.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::atomic<std::size_t> g_count{0};
+std::atomic<std::size_t> g_bytes{0};
+
+void* allocate(std::size_t size) {
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+AllocationStats allocationStats() {
+    return {g_count.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+
+void resetAllocationStats() {
+    g_count.store(0, std::memory_order_relaxed);
+    g_bytes.store(0, std::memory_order_relaxed);
+}
+
+long peakRssKb() {
+#if defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss / 1024;   // на macOS - в байтах
+#elif defined(__unix__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss;
+#else
+    return -1;
+#endif
+}
+
+// Выровненные и nothrow-формы не замещаются: контейнеры библиотек ими не пользуются
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
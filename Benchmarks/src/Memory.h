@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+
+// Счетчики глобального operator new (замещается в Memory.cpp)
+struct AllocationStats {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+};
+
+AllocationStats allocationStats();
+void resetAllocationStats();
+
+// Пиковый резидентный размер процесса в килобайтах, -1 - если недоступно
+long peakRssKb();
@@ -0,0 +1,56 @@
+// Оболочка Task5 живет в своем пространстве имен и без Qt, поэтому
+// библиотека HullAlgorithms линкуется рядом с DelaunayCore как есть
+#include "convex_hull.hpp"
+#include "dynamic_hull.hpp"
+#include "core/Geometry.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+std::function<std::size_t()> prepareTask5Hull(const std::vector<Point>& points) {
+    std::vector<Task5::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.emplace_back(p.x, p.y);
+    return [input = std::move(input)] { return Task5::ConvexHull::compute(input).size(); };
+}
+
+// Буферы выделяются один раз; замер - копирование входа и построение без выделений
+std::function<std::size_t()> prepareTask5HullSpan(const std::vector<Point>& points) {
+    std::vector<Task5::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.emplace_back(p.x, p.y);
+    std::vector<Task5::Point> scratch(input.size()), hull(input.size() + 1);
+    return [input = std::move(input), scratch = std::move(scratch), hull = std::move(hull)]() mutable {
+        std::copy(input.begin(), input.end(), scratch.begin());
+        return Task5::ConvexHull::compute(scratch.data(), scratch.size(), hull.data());
+    };
+}
+
+// Те же точки, разбитые на независимые наборы по 128 точек (формат CSR)
+std::function<std::size_t()> prepareTask5HullBatch(const std::vector<Point>& points) {
+    const std::size_t SetSize = 128;
+    std::vector<Task5::Point> input;
+    std::vector<std::size_t> offsets{0};
+    input.reserve(points.size());
+    for (const Point& p : points) {
+        input.emplace_back(p.x, p.y);
+        if (input.size() % SetSize == 0 || input.size() == points.size()) offsets.push_back(input.size());
+    }
+    return [input = std::move(input), offsets = std::move(offsets),
+            hulls = std::vector<Task5::Point>(), hullOffsets = std::vector<std::size_t>()]() mutable {
+        Task5::ConvexHull::computeBatch(input, offsets, hulls, hullOffsets);
+        return hulls.size();
+    };
+}
+
+std::function<std::size_t()> prepareTask5DynamicHull(const std::vector<Point>& points) {
+    std::vector<Task5::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.emplace_back(p.x, p.y);
+    return [input = std::move(input)] {
+        Task5::DynamicConvexHull hull;
+        hull.assign(input);
+        return hull.hull().size();
+    };
+}
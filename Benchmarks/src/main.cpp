@@ -0,0 +1,316 @@
+#include "Generators.h"
+#include "Memory.h"
+#include "core/Geometry.h"
+#include "PlaneGeometry/ClipPipeline.h"
+#include "PlaneGeometry/Geometry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCHMARK_ISOLATE_CASES
+#endif
+
+// Замеры оболочек и триангуляции на стандартных распределениях.
+// Каждый случай (алгоритм, распределение, размер) выполняется в отдельном
+// процессе, чтобы пиковый RSS относился только к нему. Результат - JSON в stdout.
+//
+//   GeometryBenchmark [--sizes 100,1000] [--algorithms a,b] [--distributions a,b]
+//                     [--seed N] [--min-time seconds]
+
+namespace {
+
+using Runner = std::function<std::size_t()>;   // возвращает размер результата
+using Prepare = Runner (*)(const std::vector<Point>&);
+
+struct Algorithm {
+    std::string_view name;
+    Prepare prepare;
+};
+
+Runner prepareDelaunayTriangulation(const std::vector<Point>& points) {
+    return [&points] { return Geometry::delaunayTriangulation(points).size(); };
+}
+
+Runner prepareDelaunayMesh(const std::vector<Point>& points) {
+    return [&points] { return Geometry::delaunayMesh(points).triangles.size(); };
+}
+
+Runner prepareDelaunayParallel(const std::vector<Point>& points) {
+    return [&points] { return Geometry::delaunayMeshParallel(points).triangles.size(); };
+}
+
+Runner preparePlaneGeometryHull(const std::vector<Point>& points) {
+    std::vector<PlaneGeometry::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.push_back({p.x, p.y});
+    return [input = std::move(input)] { return PlaneGeometry::convexHull(input).size(); };
+}
+
+// Та же оболочка без отсечения Акла-Туссена - для оценки этого этапа
+Runner preparePlaneGeometryHullNoCull(const std::vector<Point>& points) {
+    std::vector<PlaneGeometry::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.push_back({p.x, p.y});
+    PlaneGeometry::HullOptions options;
+    options.cullInterior = false;
+    return [input = std::move(input), options] { return PlaneGeometry::convexHull(input, options).size(); };
+}
+
+// Цепочка и алгоритм Чана без отсечения - сравнение на наборах с маленькой
+// оболочкой (uniform_square); точки перелома, где Чан быстрее, пока нет
+Runner preparePlaneGeometryHullWith(const std::vector<Point>& points, PlaneGeometry::HullAlgorithm algorithm) {
+    std::vector<PlaneGeometry::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.push_back({p.x, p.y});
+    PlaneGeometry::HullOptions options;
+    options.cullInterior = false;
+    options.algorithm = algorithm;
+    return [input = std::move(input), options] { return PlaneGeometry::convexHull(input, options).size(); };
+}
+
+Runner preparePlaneGeometryHullChain(const std::vector<Point>& points) {
+    return preparePlaneGeometryHullWith(points, PlaneGeometry::HullAlgorithm::MonotoneChain);
+}
+
+Runner preparePlaneGeometryHullChan(const std::vector<Point>& points) {
+    return preparePlaneGeometryHullWith(points, PlaneGeometry::HullAlgorithm::Chan);
+}
+
+Runner preparePlaneGeometryHullParallel(const std::vector<Point>& points) {
+    std::vector<PlaneGeometry::Point> input;
+    input.reserve(points.size());
+    for (const Point& p : points) input.push_back({p.x, p.y});
+    return [input = std::move(input)] { return PlaneGeometry::convexHullParallel(input).size(); };
+}
+
+// Пакетное отсечение окном: вокруг каждой точки - маленький квадрат (сторона
+// 1% размаха набора), окно - средняя половина ограничивающего прямоугольника
+Runner preparePlaneGeometryClipBatch(const std::vector<Point>& points) {
+    if (points.empty()) return [] { return std::size_t(0); };
+    auto [minX, maxX] = std::minmax_element(points.begin(), points.end(),
+                                            [](const Point& a, const Point& b) { return a.x < b.x; });
+    auto [minY, maxY] = std::minmax_element(points.begin(), points.end(),
+                                            [](const Point& a, const Point& b) { return a.y < b.y; });
+    const double x0 = minX->x, x1 = maxX->x, y0 = minY->y, y1 = maxY->y;
+    const double h = 0.005 * std::max(x1 - x0, y1 - y0);
+
+    std::vector<PlaneGeometry::Point> input;
+    std::vector<std::size_t> offsets{0};
+    input.reserve(points.size() * 4);
+    offsets.reserve(points.size() + 1);
+    for (const Point& p : points) {
+        input.push_back({p.x - h, p.y - h});
+        input.push_back({p.x + h, p.y - h});
+        input.push_back({p.x + h, p.y + h});
+        input.push_back({p.x - h, p.y + h});
+        offsets.push_back(input.size());
+    }
+    const double qx = (x1 - x0) / 4, qy = (y1 - y0) / 4;
+    PlaneGeometry::ClipWindow window({{x0 + qx, y0 + qy}, {x1 - qx, y0 + qy}, {x1 - qx, y1 - qy}, {x0 + qx, y1 - qy}});
+    return [input = std::move(input), offsets = std::move(offsets), window = std::move(window),
+            clipped = std::vector<PlaneGeometry::Point>(), clippedOffsets = std::vector<std::size_t>()]() mutable {
+        window.clipBatch(input, offsets, clipped, clippedOffsets);
+        return clipped.size();
+    };
+}
+
+} // namespace
+
+Runner prepareTask5Hull(const std::vector<Point>& points);
+Runner prepareTask5HullSpan(const std::vector<Point>& points);
+Runner prepareTask5HullBatch(const std::vector<Point>& points);
+Runner prepareTask5DynamicHull(const std::vector<Point>& points);
+
+namespace {
+
+const std::vector<Algorithm>& allAlgorithms() {
+    static const std::vector<Algorithm> algorithms = {
+        {"delaunay_triangulation", prepareDelaunayTriangulation},
+        {"delaunay_mesh",          prepareDelaunayMesh},
+        {"delaunay_parallel",      prepareDelaunayParallel},
+        {"plane_geometry_hull",    preparePlaneGeometryHull},
+        {"plane_geometry_hull_nocull", preparePlaneGeometryHullNoCull},
+        {"plane_geometry_hull_chain", preparePlaneGeometryHullChain},
+        {"plane_geometry_hull_chan", preparePlaneGeometryHullChan},
+        {"plane_geometry_hull_parallel", preparePlaneGeometryHullParallel},
+        {"plane_geometry_clip_batch", preparePlaneGeometryClipBatch},
+        {"task5_hull",             prepareTask5Hull},
+        {"task5_hull_span",        prepareTask5HullSpan},
+        {"task5_hull_batch",       prepareTask5HullBatch},
+        {"task5_dynamic_hull",     prepareTask5DynamicHull},
+    };
+    return algorithms;
+}
+
+struct Options {
+    std::vector<std::size_t>  sizes{100, 1000, 10000, 100000, 1000000, 10000000};
+    std::vector<Algorithm>    algorithms = allAlgorithms();
+    std::vector<Distribution> distributions = allDistributions();
+    std::uint64_t seed = 1;
+    double minTime = 0.2;   // повторять замер, пока суммарное время меньше (секунды)
+};
+
+struct Result {
+    double      nsPerPoint;
+    int         repeats;
+    std::size_t outputSize;
+    std::size_t allocations;     // за один прогон
+    std::size_t allocatedBytes;
+    long        peakRssKb;
+    bool        ok;
+};
+
+std::vector<std::string_view> splitList(std::string_view list) {
+    std::vector<std::string_view> items;
+    while (!list.empty()) {
+        std::size_t comma = list.find(',');
+        items.push_back(list.substr(0, comma));
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    return items;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", argv[i]);
+            return false;
+        }
+        std::string_view value = argv[++i];
+
+        if (arg == "--sizes") {
+            options.sizes.clear();
+            for (std::string_view item : splitList(value))
+                options.sizes.push_back((std::size_t)std::strtod(std::string(item).c_str(), nullptr));
+        } else if (arg == "--algorithms") {
+            options.algorithms.clear();
+            for (std::string_view item : splitList(value)) {
+                auto it = std::find_if(allAlgorithms().begin(), allAlgorithms().end(),
+                                       [&](const Algorithm& a) { return a.name == item; });
+                if (it == allAlgorithms().end()) {
+                    std::fprintf(stderr, "unknown algorithm: %.*s\n", (int)item.size(), item.data());
+                    return false;
+                }
+                options.algorithms.push_back(*it);
+            }
+        } else if (arg == "--distributions") {
+            options.distributions.clear();
+            for (std::string_view item : splitList(value)) {
+                auto distribution = parseDistribution(item);
+                if (!distribution) {
+                    std::fprintf(stderr, "unknown distribution: %.*s\n", (int)item.size(), item.data());
+                    return false;
+                }
+                options.distributions.push_back(*distribution);
+            }
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.data(), nullptr, 10);
+        } else if (arg == "--min-time") {
+            options.minTime = std::strtod(value.data(), nullptr);
+        } else {
+            std::fprintf(stderr, "unknown option: %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+    return true;
+}
+
+Result runCase(const Algorithm& algorithm, Distribution distribution, std::size_t n, const Options& options) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Point> points = generatePoints(distribution, n, options.seed);
+    Runner run = algorithm.prepare(points);
+
+    Result result{};
+    resetAllocationStats();
+    auto start = Clock::now();
+    result.outputSize = run();
+    double best = std::chrono::duration<double>(Clock::now() - start).count();
+    AllocationStats stats = allocationStats();
+    result.allocations = stats.count;
+    result.allocatedBytes = stats.bytes;
+    result.repeats = 1;
+
+    // Берется лучший из повторов: он меньше всего зависит от шума
+    double total = best;
+    while (total < options.minTime) {
+        start = Clock::now();
+        run();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        best = std::min(best, elapsed);
+        total += elapsed;
+        ++result.repeats;
+    }
+
+    result.nsPerPoint = best * 1e9 / (double)std::max<std::size_t>(n, 1);
+    result.peakRssKb = peakRssKb();
+    result.ok = true;
+    return result;
+}
+
+Result runIsolated(const Algorithm& algorithm, Distribution distribution, std::size_t n, const Options& options) {
+#ifdef BENCHMARK_ISOLATE_CASES
+    int fds[2];
+    if (pipe(fds) == 0) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            Result result = runCase(algorithm, distribution, n, options);
+            ssize_t written = write(fds[1], &result, sizeof(result));
+            _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+        }
+        close(fds[1]);
+        if (pid > 0) {
+            Result result{};
+            ssize_t got = read(fds[0], &result, sizeof(result));
+            close(fds[0]);
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (got != (ssize_t)sizeof(result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                result = Result{};   // процесс упал (например, не хватило памяти)
+            return result;
+        }
+        close(fds[0]);
+    }
+#endif
+    return runCase(algorithm, distribution, n, options);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 2;
+
+    std::printf("{\n  \"seed\": %llu,\n  \"results\": [", (unsigned long long)options.seed);
+    bool first = true;
+    for (const Algorithm& algorithm : options.algorithms) {
+        for (Distribution distribution : options.distributions) {
+            for (std::size_t n : options.sizes) {
+                Result r = runIsolated(algorithm, distribution, n, options);
+                std::string_view dist = distributionName(distribution);
+                std::printf("%s\n    {\"algorithm\": \"%.*s\", \"distribution\": \"%.*s\", \"n\": %zu, "
+                            "\"ok\": %s, \"ns_per_point\": %.3f, \"repeats\": %d, \"output_size\": %zu, "
+                            "\"allocations\": %zu, \"allocated_bytes\": %zu, \"peak_rss_kb\": %ld}",
+                            first ? "" : ",",
+                            (int)algorithm.name.size(), algorithm.name.data(), (int)dist.size(), dist.data(), n,
+                            r.ok ? "true" : "false", r.nsPerPoint, r.repeats, r.outputSize,
+                            r.allocations, r.allocatedBytes, r.peakRssKb);
+                std::fflush(stdout);
+                first = false;
+            }
+        }
+    }
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "plane_geometry/Geometry.h"
+
+namespace PlaneGeometry {
+
+enum class BooleanOp { Intersection, Union, Difference, Xor };
+
+// Набор контуров: многоугольники с дырами и несколько отдельных частей
+using PolygonSet = std::vector<Polygon>;
+
+// Булева операция над произвольными многоугольниками заметающей прямой
+// (Martinez-Rueda-Feito) за O((n + k) log n), n - число ребер, k - число
+// их пересечений. Невыпуклые и самопересекающиеся контуры, дыры и несколько
+// контуров допускаются; область задается правилом чет-нечет, так что обход
+// входных контуров не важен. Результат - контуры без самопересечений:
+// внешние против часовой, за каждым идут его дыры по часовой
+PolygonSet booleanOp(const PolygonSet& subject, const PolygonSet& clip, BooleanOp op);
+
+inline PolygonSet booleanOp(const Polygon& subject, const Polygon& clip, BooleanOp op) {
+    return booleanOp(PolygonSet{subject}, PolygonSet{clip}, op);
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "plane_geometry/Geometry.h"
+
+namespace PlaneGeometry {
+
+// Последовательное отсечение полуплоскостями на двух буферах, которые
+// чередуются между шагами: результат шага пишется в свободный буфер, а его
+// вход становится свободным для следующего. После прогрева отсечение
+// k полуплоскостями не выделяет память. Возвращаемая ссылка действительна
+// до следующего вызова; результат прошлого вызова можно снова подать на вход
+class ClipPipeline {
+public:
+    const Polygon& clip(const Polygon& subject, const HalfPlane* planes, size_t count);
+    const Polygon& clip(const Polygon& subject, const std::vector<HalfPlane>& planes) {
+        return clip(subject, planes.data(), planes.size());
+    }
+
+    // Отсечение ребрами выпуклого clip против часовой: keepLeft - пересечение
+    // с ним, иначе - то, что остается по правую сторону от всех ребер
+    const Polygon& clipByPolygon(const Polygon& subject, const Polygon& clip, bool keepLeft);
+
+private:
+    Polygon m_buffers[2];
+
+    template <class PlaneAt>
+    const Polygon& run(const Polygon& subject, size_t count, PlaneAt planeAt);
+};
+
+// Выпуклое окно отсечения против часовой. Полуплоскости его ребер и
+// ограничивающий прямоугольник готовятся один раз, дальше окно отсекает
+// сколько угодно многоугольников. Окно не меняется после построения, так что
+// одно окно можно использовать из нескольких потоков
+class ClipWindow {
+public:
+    explicit ClipWindow(const Polygon& window);
+
+    const std::vector<HalfPlane>& planes() const { return m_planes; }
+
+    // Пересечение subject с окном в буферах pipeline (ссылка действительна до
+    // следующего вызова pipeline). Многоугольник вне прямоугольника окна
+    // отбрасывается без отсечения
+    const Polygon& clip(const Polygon& subject, ClipPipeline& pipeline) const;
+
+    // Пакетное отсечение. Вход в формате CSR: многоугольник i -
+    // points[offsets[i] .. offsets[i + 1]). Его пересечение с окном
+    // записывается в clipped[clippedOffsets[i] .. clippedOffsets[i + 1])
+    // (пусто, если они не пересекаются); векторы результата переиспользуют
+    // свою память между вызовами. Многоугольники делятся на равные куски по
+    // threads потокам (0 - по числу ядер); результат от threads не зависит
+    void clipBatch(const std::vector<Point>& points, const std::vector<size_t>& offsets,
+                   std::vector<Point>& clipped, std::vector<size_t>& clippedOffsets,
+                   unsigned threads = 0) const;
+
+private:
+    std::vector<HalfPlane> m_planes;
+    Point                  m_min, m_max;   // ограничивающий прямоугольник; у пустого окна min > max
+
+    bool outsideBounds(const Point* first, const Point* last) const;
+};
+
+}
@@ -18,15 +18,40 @@ inline double dot(const Point& a, const Point& b) { return a.x*b.x + a.y*b.y; }
 
 Polygon convexHull(const std::vector<Point>& pts);
 
+// Полуплоскость слева (keepLeft) или справа от направленной прямой A -> B
+struct HalfPlane {
+    Point A, B;
+    bool keepLeft = true;
+};
+
 Polygon clipHalfPlane(const Polygon& subject, const Point& A, const Point& B, bool keepLeft);
+// То же в готовый многоугольник (его память переиспользуется); output не должен быть subject.
+// Цепочку отсечений без выделений памяти делает ClipPipeline (plane_geometry/ClipPipeline.h)
+void clipHalfPlane(const Polygon& subject, const HalfPlane& plane, Polygon& output);
 
 Polygon intersectConvex(const Polygon& A, const Polygon& B);
 
-
+// Часть A, лежащая справа от всех ребер выпуклого B против часовой. У B с
+// площадью таких точек нет, и результат пуст; разность A - B дает
+// differenceConvexDecomposed
 Polygon differenceConvex(const Polygon& A, const Polygon& B);
 
+// A - B для выпуклых A и B (B против часовой) как набор непересекающихся
+// выпуклых частей; части нулевой площади отбрасываются
+std::vector<Polygon> differenceConvexDecomposed(const Polygon& A, const Polygon& B);
+
+// Части A - B и сам B
 std::vector<Polygon> unionConvexDecomposed(const Polygon& A, const Polygon& B);
 
 bool pointInConvex(const Polygon& poly, const Point& p);
 
+// Запросы к выпуклым многоугольникам против часовой без построения их
+// пересечения: O(n + m), без выделений памяти. Отрезки и точки (меньше трех
+// вершин) допускаются.
+// Есть ли у A и B общая точка (касание считается). Ответ точный; проверка
+// заканчивается на первой найденной разделяющей оси
+bool convexOverlap(const Polygon& A, const Polygon& B);
+// Расстояние между A и B; 0, если они пересекаются, бесконечность - если один пуст
+double convexDistance(const Polygon& A, const Polygon& B);
+
 } 
@@ -0,0 +1,17 @@
+#pragma once
+#include "plane_geometry/Geometry.h"
+
+namespace PlaneGeometry {
+
+// Геометрические предикаты с адаптивной точностью (по Шевчуку).
+// Обычно это одно вычисление в double с оценкой погрешности; точная арифметика
+// разложений включается, только если знак по оценке не гарантирован.
+// Возвращаемое значение - приближение определителя с точным знаком.
+
+// > 0: тройка a, b, c против часовой стрелки (c слева от ab), < 0 - по часовой, 0 - на одной прямой
+double orient2d(const Point& a, const Point& b, const Point& c);
+
+// Для a, b, c против часовой: > 0 - d внутри описанной окружности, < 0 - снаружи, 0 - на ней
+double incircle(const Point& a, const Point& b, const Point& c, const Point& d);
+
+}
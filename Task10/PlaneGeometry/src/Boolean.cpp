@@ -0,0 +1,596 @@
+#include "plane_geometry/Boolean.h"
+#include "plane_geometry/Predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <set>
+#include <utility>
+
+namespace PlaneGeometry {
+
+namespace {
+
+// Допуск притягивания точки пересечения к концу ребра, в ulp масштаба координат
+constexpr double SnapUlps = 16;
+
+bool samePoint(const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }
+
+bool lexLess(const Point& a, const Point& b) {
+    if (a.x == b.x) return a.y < b.y;
+    return a.x < b.x;
+}
+
+struct SweepEvent;
+
+// Порядок ребер на заметающей прямой снизу вверх
+struct SegmentBelow {
+    bool operator()(const SweepEvent* le1, const SweepEvent* le2) const;
+};
+using StatusLine = std::multiset<SweepEvent*, SegmentBelow>;
+
+// Конец ребра. Ребро - пара событий, левое и правое, связанных через other
+struct SweepEvent {
+    Point point;
+    bool left = false;
+    bool subject = true;           // ребро первого операнда
+    int contour = 0;               // номер входного контура
+    SweepEvent* other = nullptr;
+    // Исходное ребро слева направо. Концы частей разделенного ребра округлены
+    // и лежат на его прямой лишь приближенно, поэтому стороны и наложения
+    // определяются по исходному ребру
+    Point lineA, lineB;
+
+    // Вертикальный луч снизу, пересекая ребро, выходит из своего многоугольника
+    bool inOut = false;
+    // То же для ближайшего снизу ребра другого многоугольника: true - над ребром
+    // мы вне другого многоугольника
+    bool otherInOut = false;
+    // 0 - ребро не входит в результат; +1 - результат над ребром, -1 - под ним.
+    // Из пучка совпадающих ребер границей результата служит только верхнее
+    int resultTransition = 0;
+    bool resultBelow = false;             // точка под пучком ребра в результате
+    SweepEvent* prevInResult = nullptr;   // ближайшее снизу ребро результата
+
+    StatusLine::iterator position;        // место левого события на заметающей прямой
+    bool inStatus = false;
+
+    size_t index = 0;                     // позиция в обходе вершины при сборке контуров
+    int outputContour = -1;
+
+    bool inResult() const { return resultTransition != 0; }
+    bool isVertical() const { return point.x == other->point.x; }
+    // > 0 - p выше прямой ребра, < 0 - ниже
+    double side(const Point& p) const { return orient2d(lineA, lineB, p); }
+};
+
+bool onSameLine(const SweepEvent* e1, const SweepEvent* e2) {
+    return orient2d(e1->lineA, e1->lineB, e2->lineA) == 0 &&
+           orient2d(e1->lineA, e1->lineB, e2->lineB) == 0;
+}
+
+// Ребра с общими концами: после деления наложений это одна и та же часть
+bool coincide(const SweepEvent* le1, const SweepEvent* le2) {
+    return samePoint(le1->point, le2->point) && samePoint(le1->other->point, le2->other->point);
+}
+
+// e1 обрабатывается после e2
+bool after(const SweepEvent* e1, const SweepEvent* e2) {
+    const Point& p1 = e1->point;
+    const Point& p2 = e2->point;
+    if (p1.x != p2.x) return p1.x > p2.x;
+    if (p1.y != p2.y) return p1.y > p2.y;
+    // Общая точка: правые концы раньше левых
+    if (e1->left != e2->left) return e1->left;
+    // Оба левые или оба правые: нижнее ребро раньше
+    if (!onSameLine(e1, e2)) {
+        const double side = e1->side(e2->other->point);
+        if (side != 0) return side < 0;
+    }
+    // На одной прямой: ребро первого операнда раньше
+    return !e1->subject && e2->subject;
+}
+
+struct EventAfter {
+    bool operator()(const SweepEvent* e1, const SweepEvent* e2) const { return after(e1, e2); }
+};
+
+bool SegmentBelow::operator()(const SweepEvent* le1, const SweepEvent* le2) const {
+    if (le1 == le2) return false;
+    if (!onSameLine(le1, le2)) {
+        // Ребра не на одной прямой
+        if (samePoint(le1->point, le2->point)) {
+            double side = le1->side(le2->other->point);
+            if (side == 0) side = -le2->side(le1->other->point);
+            return side > 0;
+        }
+        if (le1->point.x == le2->point.x) {
+            // Вертикальное ребро считается чуть наклоненным вправо вверх, поэтому
+            // ребро, начинающееся на нем, идет ниже него
+            if (le2->isVertical() && le1->point.y > le2->point.y && le1->point.y < le2->other->point.y)
+                return true;
+            if (le1->isVertical() && le2->point.y > le1->point.y && le2->point.y < le1->other->point.y)
+                return false;
+            return le1->point.y < le2->point.y;
+        }
+        // Сравнение относительно ребра, попавшего на прямую раньше. Если
+        // левый конец другого ребра лежит на нем, решает правый конец
+        if (after(le1, le2)) {
+            double side = le2->side(le1->point);
+            if (side == 0) side = le2->side(le1->other->point);
+            return side < 0;
+        }
+        double side = le1->side(le2->point);
+        if (side == 0) side = le1->side(le2->other->point);
+        return side > 0;
+    }
+    // На одной прямой
+    if (le1->subject != le2->subject) return le1->subject;
+    if (samePoint(le1->point, le2->point)) return le1->contour < le2->contour;
+    return !after(le1, le2);
+}
+
+// Общая часть отрезков ab и cd на одной прямой: число точек и ее концы
+int collinearOverlap(const Point& a, const Point& b, const Point& c, const Point& d, Point out[2]) {
+    Point lo1 = a, hi1 = b, lo2 = c, hi2 = d;
+    if (lexLess(hi1, lo1)) std::swap(lo1, hi1);
+    if (lexLess(hi2, lo2)) std::swap(lo2, hi2);
+    const Point lo = lexLess(lo1, lo2) ? lo2 : lo1;
+    const Point hi = lexLess(hi1, hi2) ? hi1 : hi2;
+    if (lexLess(hi, lo)) return 0;
+    out[0] = lo;
+    if (samePoint(lo, hi)) return 1;
+    out[1] = hi;
+    return 2;
+}
+
+// p в пределах части ребра, концы включительно
+bool withinPiece(const SweepEvent* le, const Point& p) {
+    const Point& a = le->point;
+    const Point& b = le->other->point;
+    const Point& lo = lexLess(a, b) ? a : b;
+    const Point& hi = lexLess(a, b) ? b : a;
+    return !lexLess(p, lo) && !lexLess(hi, p);
+}
+
+// Пересечение ребер le1 и le2 не на одной прямой: 0 или 1. Стороны концов
+// определяются точными предикатами относительно исходных ребер, в double
+// считается только точка собственного пересечения
+int segmentIntersection(const SweepEvent* le1, const SweepEvent* le2, double tolerance, Point& out) {
+    const Point& a = le1->point;
+    const Point& b = le1->other->point;
+    const Point& c = le2->point;
+    const Point& d = le2->other->point;
+    const double o1 = le1->side(c);
+    const double o2 = le1->side(d);
+    if ((o1 > 0 && o2 > 0) || (o1 < 0 && o2 < 0)) return 0;
+    const double o3 = le2->side(a);
+    const double o4 = le2->side(b);
+    if ((o3 > 0 && o4 > 0) || (o3 < 0 && o4 < 0)) return 0;
+
+    if (o1 == 0 || o2 == 0 || o3 == 0 || o4 == 0) {
+        // Конец одного ребра на прямой другого - единственная общая точка прямых
+        if (o1 == 0 && withinPiece(le1, c)) { out = c; return 1; }
+        if (o2 == 0 && withinPiece(le1, d)) { out = d; return 1; }
+        if (o3 == 0 && withinPiece(le2, a)) { out = a; return 1; }
+        if (o4 == 0 && withinPiece(le2, b)) { out = b; return 1; }
+        return 0;
+    }
+
+    // Точка пересечения исходных прямых
+    const Point r = le1->lineB - le1->lineA;
+    const Point s = le2->lineB - le2->lineA;
+    const double rxs = cross(r, s);
+    const double t = rxs != 0 ? cross(le2->lineA - le1->lineA, s) / rxs : 0.5;
+    Point p{le1->lineA.x + t*r.x, le1->lineA.y + t*r.y};
+    // Округление не должно выносить точку за пределы обоих отрезков
+    p.x = std::clamp(p.x, std::max(std::min(a.x, b.x), std::min(c.x, d.x)),
+                          std::min(std::max(a.x, b.x), std::max(c.x, d.x)));
+    p.y = std::clamp(p.y, std::max(std::min(a.y, b.y), std::min(c.y, d.y)),
+                          std::min(std::max(a.y, b.y), std::max(c.y, d.y)));
+    // Точка в пределах погрешности от конца - это сам конец: иначе рядом
+    // с вершиной появляются ребра длиной в несколько ulp, и их деление
+    // порождает новые пересечения без конца
+    for (const Point* end : {&a, &b, &c, &d})
+        if (std::fabs(p.x - end->x) <= tolerance && std::fabs(p.y - end->y) <= tolerance) {
+            p = *end;
+            break;
+        }
+    out = p;
+    return 1;
+}
+
+struct OutputContour {
+    Polygon points;
+    bool outer = true;
+    int holeOf = -1;            // внешний контур, дырой которого является этот
+    std::vector<int> holes;
+};
+
+class BooleanSweep {
+public:
+    explicit BooleanSweep(BooleanOp op) : m_op(op) {}
+
+    PolygonSet run(const PolygonSet& subject, const PolygonSet& clip);
+
+private:
+    BooleanOp m_op;
+    std::deque<SweepEvent> m_events;   // deque не переносит события при росте
+    std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventAfter> m_queue;
+    StatusLine m_status;
+    std::vector<SweepEvent*> m_processed;
+    std::vector<SweepEvent*> m_bundle;
+    // Точки деления ребер. Пересечения нескольких ребер в одной точке,
+    // посчитанные по разным парам, расходятся на ulp и сводятся к первой
+    std::set<Point, bool (*)(const Point&, const Point&)> m_vertices{lexLess};
+    double m_tolerance = 0;             // допуск совпадения точек
+    int m_contours = 0;
+
+    SweepEvent* newEvent(const Point& p, bool left, SweepEvent* other, bool subject, int contour);
+    void addContour(const Polygon& contour, bool subject);
+    bool inResult(bool subjectIn, bool clipIn) const;
+    void computeFields(SweepEvent* e, SweepEvent* prev);
+    void computeBundle(SweepEvent* e);
+    void divideSegment(SweepEvent* le, const Point& p);
+    void divideEdge(SweepEvent* le, const Point& p);
+    int  possibleIntersection(SweepEvent* le1, SweepEvent* le2);
+    PolygonSet connectEdges();
+};
+
+SweepEvent* BooleanSweep::newEvent(const Point& p, bool left, SweepEvent* other, bool subject, int contour) {
+    m_events.emplace_back();
+    SweepEvent* e = &m_events.back();
+    e->point = p;
+    e->left = left;
+    e->other = other;
+    e->subject = subject;
+    e->contour = contour;
+    return e;
+}
+
+void BooleanSweep::addContour(const Polygon& contour, bool subject) {
+    const int id = m_contours++;
+    const size_t n = contour.size();
+    for (size_t i = 0; i < n; ++i) {
+        const Point& p = contour[i];
+        const Point& q = contour[(i+1) % n];
+        if (samePoint(p, q)) continue;   // вырожденные ребра не нужны
+        SweepEvent* e1 = newEvent(p, false, nullptr, subject, id);
+        SweepEvent* e2 = newEvent(q, false, e1, subject, id);
+        e1->other = e2;
+        e1->lineA = e2->lineA = lexLess(p, q) ? p : q;
+        e1->lineB = e2->lineB = lexLess(p, q) ? q : p;
+        if (after(e1, e2)) e2->left = true;
+        else               e1->left = true;
+        m_queue.push(e1);
+        m_queue.push(e2);
+    }
+}
+
+bool BooleanSweep::inResult(bool subjectIn, bool clipIn) const {
+    switch (m_op) {
+    case BooleanOp::Intersection: return subjectIn && clipIn;
+    case BooleanOp::Union:        return subjectIn || clipIn;
+    case BooleanOp::Difference:   return subjectIn && !clipIn;
+    case BooleanOp::Xor:          return subjectIn != clipIn;
+    }
+    return false;
+}
+
+// Состояние ребра по ближайшему ребру снизу
+void BooleanSweep::computeFields(SweepEvent* e, SweepEvent* prev) {
+    e->prevInResult = nullptr;
+    if (!prev) {
+        e->inOut = false;
+        e->otherInOut = true;
+    } else {
+        if (e->subject == prev->subject) {
+            e->inOut = !prev->inOut;
+            e->otherInOut = prev->otherInOut;
+        } else {
+            e->inOut = !prev->otherInOut;
+            e->otherInOut = prev->inOut;
+        }
+    }
+
+    // Совпадающие ребра лежат на прямой друг над другом, как если бы были
+    // чуть разнесены, и поля каждого считаются обычным образом. Граница
+    // результата - между областью под нижним ребром пучка и над верхним
+    const bool thisAbove = !e->inOut;
+    const bool thatAbove = !e->otherInOut;
+    const bool above = e->subject ? inResult(thisAbove, thatAbove) : inResult(thatAbove, thisAbove);
+    e->resultBelow = e->subject ? inResult(!thisAbove, thatAbove) : inResult(thatAbove, !thisAbove);
+    if (prev && coincide(prev, e)) {
+        e->resultBelow = prev->resultBelow;
+        prev->resultTransition = 0;
+    }
+    e->resultTransition = above == e->resultBelow ? 0 : above ? 1 : -1;
+    if (prev)
+        e->prevInResult = (!prev->inResult() || prev->isVertical()) ? prev->prevInResult : prev;
+}
+
+// Пересчет полей пучка совпадающих ребер, в который входит e, снизу вверх
+void BooleanSweep::computeBundle(SweepEvent* e) {
+    auto it = e->position;
+    while (it != m_status.begin() && coincide(*std::prev(it), *it)) --it;
+    for (;;) {
+        SweepEvent* current = *it;
+        computeFields(current, it == m_status.begin() ? nullptr : *std::prev(it));
+        if (++it == m_status.end() || !coincide(current, *it)) break;
+    }
+}
+
+// Делит ребро le точкой p на два, а с ним и совпадающие с ним ребра на
+// заметающей прямой - иначе пучок распадется и его граница потеряется
+void BooleanSweep::divideSegment(SweepEvent* le, const Point& p) {
+    if (samePoint(le->point, p) || samePoint(le->other->point, p)) return;
+    if (le->inStatus) {
+        auto first = le->position, last = std::next(le->position);
+        while (first != m_status.begin() && coincide(*std::prev(first), le)) --first;
+        while (last != m_status.end() && coincide(*last, le)) ++last;
+        m_bundle.assign(first, last);
+        for (SweepEvent* e : m_bundle) divideEdge(e, p);
+        return;
+    }
+    divideEdge(le, p);
+}
+
+void BooleanSweep::divideEdge(SweepEvent* le, const Point& p) {
+    SweepEvent* r = newEvent(p, false, le, le->subject, le->contour);
+    SweepEvent* l = newEvent(p, true, le->other, le->subject, le->contour);
+    r->lineA = l->lineA = le->lineA;
+    r->lineB = l->lineB = le->lineB;
+    // Округленная точка могла оказаться правее конца ребра
+    if (after(l, le->other)) {
+        le->other->left = true;
+        l->left = false;
+    }
+    le->other->other = l;
+    le->other = r;
+    m_queue.push(l);
+    m_queue.push(r);
+}
+
+// Соседние на прямой ребра: при пересечении делит их. 2 - совпадают левые
+// концы и поля ребер надо пересчитать
+int BooleanSweep::possibleIntersection(SweepEvent* le1, SweepEvent* le2) {
+    Point ip[2];
+    const Point& a = le1->point;
+    const Point& b = le1->other->point;
+    const Point& c = le2->point;
+    const Point& d = le2->other->point;
+    const int n = onSameLine(le1, le2) ? collinearOverlap(a, b, c, d, ip)
+                                       : segmentIntersection(le1, le2, m_tolerance, ip[0]);
+    if (n == 0) return 0;
+    if (n == 1 && (samePoint(le1->point, le2->point) || samePoint(le1->other->point, le2->other->point)))
+        return 0;   // общий конец
+
+    if (n == 1) {
+        if (!samePoint(a, ip[0]) && !samePoint(b, ip[0]) && !samePoint(c, ip[0]) && !samePoint(d, ip[0])) {
+            auto it = m_vertices.lower_bound({ip[0].x - m_tolerance, -std::numeric_limits<double>::infinity()});
+            for (; it != m_vertices.end() && it->x <= ip[0].x + m_tolerance; ++it)
+                if (std::fabs(it->y - ip[0].y) <= m_tolerance && withinPiece(le1, *it) && withinPiece(le2, *it)) {
+                    ip[0] = *it;
+                    break;
+                }
+            m_vertices.insert(ip[0]);
+        }
+        if (!samePoint(le1->point, ip[0]) && !samePoint(le1->other->point, ip[0])) divideSegment(le1, ip[0]);
+        if (!samePoint(le2->point, ip[0]) && !samePoint(le2->other->point, ip[0])) divideSegment(le2, ip[0]);
+        return 1;
+    }
+
+    // Ребра накладываются: их общая часть выделяется в отдельные совпадающие ребра
+    SweepEvent* events[4];
+    int count = 0;
+    const bool leftCoincide = samePoint(le1->point, le2->point);
+    const bool rightCoincide = samePoint(le1->other->point, le2->other->point);
+    if (!leftCoincide) {
+        if (after(le1, le2)) { events[count++] = le2; events[count++] = le1; }
+        else                 { events[count++] = le1; events[count++] = le2; }
+    }
+    if (!rightCoincide) {
+        if (after(le1->other, le2->other)) { events[count++] = le2->other; events[count++] = le1->other; }
+        else                               { events[count++] = le1->other; events[count++] = le2->other; }
+    }
+
+    if (leftCoincide) {
+        if (!rightCoincide) divideSegment(events[1]->other, events[0]->point);
+        return 2;
+    }
+    if (rightCoincide) {
+        divideSegment(events[0], events[1]->point);
+        return 3;
+    }
+    if (events[0] != events[3]->other) {
+        // Ни одно ребро не содержит другое целиком
+        divideSegment(events[0], events[1]->point);
+        divideSegment(events[1], events[2]->point);
+        return 3;
+    }
+    // Одно ребро содержит другое
+    divideSegment(events[0], events[1]->point);
+    divideSegment(events[3]->other, events[2]->point);
+    return 3;
+}
+
+PolygonSet BooleanSweep::run(const PolygonSet& subject, const PolygonSet& clip) {
+    constexpr double Inf = std::numeric_limits<double>::infinity();
+    double subjectMaxX = -Inf, clipMaxX = -Inf;
+    double subjectMin[2] = {Inf, Inf}, subjectMax[2] = {-Inf, -Inf};
+    double clipMin[2] = {Inf, Inf}, clipMax[2] = {-Inf, -Inf};
+    auto bounds = [](const PolygonSet& set, double* lo, double* hi) {
+        for (const Polygon& c : set)
+            for (const Point& p : c) {
+                lo[0] = std::min(lo[0], p.x); hi[0] = std::max(hi[0], p.x);
+                lo[1] = std::min(lo[1], p.y); hi[1] = std::max(hi[1], p.y);
+            }
+    };
+    bounds(subject, subjectMin, subjectMax);
+    bounds(clip, clipMin, clipMax);
+    double scale = 0;
+    for (double v : {subjectMin[0], subjectMin[1], subjectMax[0], subjectMax[1],
+                     clipMin[0], clipMin[1], clipMax[0], clipMax[1]})
+        if (std::isfinite(v)) scale = std::max(scale, std::fabs(v));
+    m_tolerance = SnapUlps * std::numeric_limits<double>::epsilon() * scale;
+    subjectMaxX = subjectMax[0];
+    clipMaxX = clipMax[0];
+
+    // Пересечение с непересекающимися прямоугольниками пусто
+    if (m_op == BooleanOp::Intersection &&
+        (subjectMin[0] > clipMax[0] || clipMin[0] > subjectMax[0] ||
+         subjectMin[1] > clipMax[1] || clipMin[1] > subjectMax[1]))
+        return {};
+
+    for (const Polygon& c : subject) addContour(c, true);
+    for (const Polygon& c : clip) addContour(c, false);
+
+    // Правее этой границы ребер результата нет
+    double rightBound = Inf;
+    if (m_op == BooleanOp::Intersection) rightBound = std::min(subjectMaxX, clipMaxX);
+    if (m_op == BooleanOp::Difference)   rightBound = subjectMaxX;
+
+    m_processed.reserve(m_queue.size());
+    while (!m_queue.empty()) {
+        SweepEvent* e = m_queue.top();
+        m_queue.pop();
+        if (e->point.x > rightBound) break;
+        m_processed.push_back(e);
+
+        if (e->left) {
+            e->position = m_status.insert(e);
+            e->inStatus = true;
+            SweepEvent* prev = e->position == m_status.begin() ? nullptr : *std::prev(e->position);
+            auto nextIt = std::next(e->position);
+            SweepEvent* next = nextIt == m_status.end() ? nullptr : *nextIt;
+
+            computeFields(e, prev);
+            if (next && possibleIntersection(e, next) == 2) computeBundle(e);
+            if (prev && possibleIntersection(prev, e) == 2) computeBundle(e);
+            // Левый конец e лежит на соседнем ребре, и оно разделено в этой
+            // точке. Порядок e относительно продолжения соседа тогда решен
+            // округлением - e возвращается в очередь и встанет на прямую
+            // после того, как сосед закончится
+            if ((next && samePoint(next->other->point, e->point)) ||
+                (prev && samePoint(prev->other->point, e->point))) {
+                m_status.erase(e->position);
+                e->inStatus = false;
+                m_processed.pop_back();
+                m_queue.push(e);
+            }
+        } else {
+            SweepEvent* le = e->other;
+            if (!le->inStatus) continue;
+            auto it = le->position;
+            SweepEvent* prev = it == m_status.begin() ? nullptr : *std::prev(it);
+            auto nextIt = std::next(it);
+            SweepEvent* next = nextIt == m_status.end() ? nullptr : *nextIt;
+            m_status.erase(it);
+            le->inStatus = false;
+            // Ребра, ставшие соседями, могут пересекаться
+            if (prev && next) possibleIntersection(prev, next);
+        }
+    }
+    return connectEdges();
+}
+
+// Сборка ребер результата в контуры. Ребро направляется так, чтобы результат
+// был слева от него (по resultTransition), и в каждой вершине контур
+// продолжается первым по часовой исходящим ребром - самым левым поворотом.
+// Так внешние контуры выходят против часовой, дыры - по часовой, а касания
+// контуров в вершине не дают пересечений
+PolygonSet BooleanSweep::connectEdges() {
+    std::vector<SweepEvent*> events;
+    for (SweepEvent* e : m_processed)
+        if (e->left ? e->inResult() : e->other->inResult()) events.push_back(e);
+    std::stable_sort(events.begin(), events.end(),
+                     [](const SweepEvent* a, const SweepEvent* b) { return after(b, a); });
+    const size_t n = events.size();
+
+    // События одной точки идут подряд: правые концы снизу вверх, затем левые
+    // снизу вверх. Против часовой начиная с направления вниз это левые концы
+    // в том же порядке и правые в обратном
+    std::vector<SweepEvent*> around(n);
+    std::vector<size_t> groupBegin(n), groupEnd(n);
+    for (size_t begin = 0; begin < n;) {
+        size_t end = begin;
+        while (end < n && samePoint(events[end]->point, events[begin]->point)) ++end;
+        size_t firstLeft = begin;
+        while (firstLeft < end && !events[firstLeft]->left) ++firstLeft;
+        size_t k = begin;
+        for (size_t j = firstLeft; j < end; ++j) around[k++] = events[j];
+        for (size_t j = firstLeft; j > begin; --j) around[k++] = events[j-1];
+        for (size_t j = begin; j < end; ++j) {
+            around[j]->index = j;
+            groupBegin[j] = begin;
+            groupEnd[j] = end;
+        }
+        begin = end;
+    }
+    auto outgoing = [](const SweepEvent* e) {
+        return e->left ? e->resultTransition > 0 : e->other->resultTransition < 0;
+    };
+
+    std::vector<OutputContour> contours;
+    for (SweepEvent* start : events) {
+        if (!start->left || start->outputContour >= 0) continue;
+        // start - нижнее ребро самой левой вершины контура: над ним результат
+        // у внешнего контура, под ним - у дыры
+        const int id = (int)contours.size();
+        OutputContour contour;
+        contour.outer = start->resultTransition > 0;
+        if (!contour.outer) {
+            // Дыра лежит в том внешнем контуре, внутрь которого смотрит ближайшее снизу ребро
+            const SweepEvent* lower = start->prevInResult;
+            if (lower && lower->outputContour >= 0 && lower->resultTransition > 0) {
+                const OutputContour& below = contours[lower->outputContour];
+                contour.holeOf = below.outer ? lower->outputContour : below.holeOf;
+            }
+            if (contour.holeOf >= 0) contours[contour.holeOf].holes.push_back(id);
+        }
+
+        SweepEvent* from = contour.outer ? start : start->other;
+        for (;;) {
+            SweepEvent* edge = from->left ? from : from->other;
+            edge->outputContour = edge->other->outputContour = id;
+            contour.points.push_back(from->point);
+
+            const SweepEvent* to = from->other;
+            const size_t begin = groupBegin[to->index];
+            const size_t size = groupEnd[to->index] - begin;
+            SweepEvent* next = nullptr;
+            for (size_t step = 1; step < size && !next; ++step) {
+                SweepEvent* e = around[begin + (to->index - begin + size - step) % size];
+                if (outgoing(e)) next = e;
+            }
+            // Исходящее ребро уже в контуре - контур замкнулся
+            if (!next || (next->left ? next : next->other)->outputContour >= 0) break;
+            from = next;
+        }
+        contours.push_back(std::move(contour));
+    }
+
+    PolygonSet result;
+    for (OutputContour& c : contours) {
+        if (!c.outer || c.points.size() < 3) continue;
+        result.push_back(std::move(c.points));
+        for (int h : c.holes)
+            if (contours[h].points.size() >= 3) result.push_back(std::move(contours[h].points));
+    }
+    // Дыры, для которых не нашлось внешнего контура (только при вырождениях)
+    for (OutputContour& c : contours)
+        if (!c.outer && c.holeOf < 0 && c.points.size() >= 3) result.push_back(std::move(c.points));
+    return result;
+}
+
+} // namespace
+
+PolygonSet booleanOp(const PolygonSet& subject, const PolygonSet& clip, BooleanOp op) {
+    BooleanSweep sweep(op);
+    return sweep.run(subject, clip);
+}
+
+}
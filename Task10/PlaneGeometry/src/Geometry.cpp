@@ -1,6 +1,11 @@
 #include "plane_geometry/Geometry.h"
+#include "plane_geometry/ClipPipeline.h"
+#include "plane_geometry/Predicates.h"
 #include <algorithm>
 #include <cmath>
+#include <future>
+#include <limits>
+#include <thread>
 
 namespace PlaneGeometry {
 
@@ -16,13 +21,13 @@ Polygon convexHull(const std::vector<Point>& P) {
 
     std::sort(pts.begin(), pts.end(), lexLess);
     for (const auto& p : pts) {
-        while (H.size() >= 2 && cross(H[H.size()-2], H.back(), p) <= 0) H.pop_back();
+        while (H.size() >= 2 && orient2d(H[H.size()-2], H.back(), p) <= 0) H.pop_back();
         H.push_back(p);
     }
     size_t t = H.size();
     for (int i = (int)pts.size()-2; i >= 0; --i) {
         const auto& p = pts[i];
-        while (H.size() > t && cross(H[H.size()-2], H.back(), p) <= 0) H.pop_back();
+        while (H.size() > t && orient2d(H[H.size()-2], H.back(), p) <= 0) H.pop_back();
         H.push_back(p);
     }
     if (!H.empty()) H.pop_back();
@@ -31,10 +36,10 @@ Polygon convexHull(const std::vector<Point>& P) {
 }
 
 static bool insideLeft(const Point& A, const Point& B, const Point& P) {
-    return cross(A, B, P) >= -1e-12;
+    return orient2d(A, B, P) >= 0;
 }
 static bool insideRight(const Point& A, const Point& B, const Point& P) {
-    return cross(A, B, P) <=  1e-12;
+    return orient2d(A, B, P) <= 0;
 }
 
 static bool segmentIntersectProper(const Point& a, const Point& b,
@@ -43,16 +48,20 @@ static bool segmentIntersectProper(const Point& a, const Point& b,
 {
     Point r = b - a, s = d - c;
     double rxs = cross(r, s);
-    if (std::fabs(rxs) < 1e-15) return false; 
-    double t = cross(c - a, s) / rxs;
+    // Концы отрезка по разные стороны прямой (точный предикат), поэтому rxs
+    // обращается в ноль только из-за округления разностей
+    if (rxs == 0) return false;
+    double t = std::clamp(cross(c - a, s) / rxs, 0.0, 1.0);
     out = { a.x + t*r.x, a.y + t*r.y };
     return true;
 }
 
-Polygon clipHalfPlane(const Polygon& subject, const Point& A, const Point& B, bool keepLeft) {
-    if (subject.empty()) return {};
-    Polygon output;
-    auto isIn = keepLeft ? insideLeft : insideRight;
+void clipHalfPlane(const Polygon& subject, const HalfPlane& plane, Polygon& output) {
+    output.clear();
+    if (subject.empty()) return;
+    const Point& A = plane.A;
+    const Point& B = plane.B;
+    auto isIn = plane.keepLeft ? insideLeft : insideRight;
 
     Point S = subject.back();
     bool Sin = isIn(A, B, S);
@@ -75,57 +84,378 @@ Polygon clipHalfPlane(const Polygon& subject, const Point& A, const Point& B, bo
         } 
         S = E; Sin = Ein;
     }
+}
+
+Polygon clipHalfPlane(const Polygon& subject, const Point& A, const Point& B, bool keepLeft) {
+    Polygon output;
+    clipHalfPlane(subject, HalfPlane{A, B, keepLeft}, output);
     return output;
 }
 
+template <class PlaneAt>
+const Polygon& ClipPipeline::run(const Polygon& subject, size_t count, PlaneAt planeAt) {
+    // Вход может быть результатом прошлого вызова - тогда первым пишется другой буфер
+    int next = &subject == &m_buffers[0] ? 1 : 0;
+    const Polygon* current = &subject;
+    for (size_t i = 0; i < count && !current->empty(); ++i) {
+        clipHalfPlane(*current, planeAt(i), m_buffers[next]);
+        current = &m_buffers[next];
+        next ^= 1;
+    }
+    // Ни одного шага (нет полуплоскостей или пустой вход) - результатом остается сам вход
+    if (current == &subject && current != &m_buffers[0] && current != &m_buffers[1]) {
+        m_buffers[next] = subject;
+        current = &m_buffers[next];
+    }
+    return *current;
+}
+
+const Polygon& ClipPipeline::clip(const Polygon& subject, const HalfPlane* planes, size_t count) {
+    return run(subject, count, [&](size_t i) { return planes[i]; });
+}
+
+const Polygon& ClipPipeline::clipByPolygon(const Polygon& subject, const Polygon& clip, bool keepLeft) {
+    const size_t m = clip.size();
+    return run(subject, m, [&](size_t i) { return HalfPlane{clip[i], clip[(i+1) % m], keepLeft}; });
+}
+
+// Меньшие пакеты не окупают запуск потока
+static constexpr size_t ParallelClipMinChunk = 1 << 10;
+
+ClipWindow::ClipWindow(const Polygon& window) {
+    constexpr double Inf = std::numeric_limits<double>::infinity();
+    m_min = {Inf, Inf};
+    m_max = {-Inf, -Inf};
+    // Окно меньше чем из трех вершин пусто: любой многоугольник вне его прямоугольника
+    if (window.size() < 3) return;
+    const size_t m = window.size();
+    m_planes.reserve(m);
+    for (size_t i = 0; i < m; ++i) {
+        m_planes.push_back(HalfPlane{window[i], window[(i+1) % m], true});
+        m_min = {std::min(m_min.x, window[i].x), std::min(m_min.y, window[i].y)};
+        m_max = {std::max(m_max.x, window[i].x), std::max(m_max.y, window[i].y)};
+    }
+}
+
+// Все вершины по одну сторону от прямоугольника окна
+bool ClipWindow::outsideBounds(const Point* first, const Point* last) const {
+    bool left = true, right = true, below = true, above = true;
+    for (const Point* p = first; p != last; ++p) {
+        left  &= p->x < m_min.x;
+        right &= p->x > m_max.x;
+        below &= p->y < m_min.y;
+        above &= p->y > m_max.y;
+    }
+    return left || right || below || above;
+}
+
+const Polygon& ClipWindow::clip(const Polygon& subject, ClipPipeline& pipeline) const {
+    static const Polygon empty;
+    if (outsideBounds(subject.data(), subject.data() + subject.size())) return empty;
+    return pipeline.clip(subject, m_planes);
+}
+
+void ClipWindow::clipBatch(const std::vector<Point>& points, const std::vector<size_t>& offsets,
+                           std::vector<Point>& clipped, std::vector<size_t>& clippedOffsets,
+                           unsigned threads) const {
+    const size_t count = offsets.empty() ? 0 : offsets.size() - 1;
+    clipped.clear();
+    clippedOffsets.assign(count + 1, 0);
+    if (count == 0) return;
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, count / ParallelClipMinChunk));
+
+    // Кусок пишет пересечения подряд в свой буфер (первый - сразу в clipped),
+    // а их размеры - в clippedOffsets[i + 1]; затем буферы склеиваются по порядку
+    std::vector<std::vector<Point>> parts(chunks - 1);
+    auto work = [&](size_t c, size_t begin, size_t end) {
+        std::vector<Point>& out = c == 0 ? clipped : parts[c - 1];
+        ClipPipeline pipeline;
+        Polygon subject;
+        for (size_t i = begin; i < end; ++i) {
+            const Point* first = points.data() + offsets[i];
+            const Point* last = points.data() + offsets[i + 1];
+            if (outsideBounds(first, last)) continue;
+            subject.assign(first, last);
+            const Polygon& result = pipeline.clip(subject, m_planes);
+            out.insert(out.end(), result.begin(), result.end());
+            clippedOffsets[i + 1] = result.size();
+        }
+    };
+    if (chunks == 1) {
+        work(0, 0, count);
+    } else {
+        std::vector<std::future<void>> tasks;
+        for (size_t c = 0; c < chunks; ++c)
+            tasks.push_back(std::async(std::launch::async, work, c, count * c / chunks, count * (c + 1) / chunks));
+        for (auto& task : tasks) task.get();
+    }
+
+    for (size_t i = 0; i < count; ++i) clippedOffsets[i + 1] += clippedOffsets[i];
+    for (const std::vector<Point>& part : parts) clipped.insert(clipped.end(), part.begin(), part.end());
+}
+
+// Все повороты строго влево: выпуклый многоугольник против часовой без
+// повторных вершин и трех точек на одной прямой
+static bool strictlyConvexCCW(const Polygon& P) {
+    const size_t n = P.size();
+    if (n < 3) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (orient2d(P[i], P[(i+1) % n], P[(i+2) % n]) <= 0) return false;
+    }
+    return true;
+}
+
+static int sign(double v) { return (v > 0) - (v < 0); }
+
+// Пересечение строго выпуклых многоугольников против часовой за O(n + m)
+// (О'Рурк - Чиен - Олсон - Наддор): по границам P и Q идут одновременно,
+// каждый шаг продвигает ребро, которое "догоняет" другое, и выводит вершины
+// той границы, что сейчас внутри. false - если встретилось вырождение
+// (вершина на прямой ребра, касание, почти параллельные ребра): тогда
+// пересечение строится отсечением полуплоскостями
+static bool intersectConvexLinear(const Polygon& P, const Polygon& Q, Polygon& out) {
+    enum class Inside { Unknown, P, Q };
+    const size_t n = P.size(), m = Q.size();
+    size_t a = 0, b = 0, aa = 0, ba = 0;
+    Inside inflag = Inside::Unknown;
+    out.clear();
+
+    do {
+        const Point& pa1 = P[(a + n - 1) % n];
+        const Point& pa  = P[a];
+        const Point& qb1 = Q[(b + m - 1) % m];
+        const Point& qb  = Q[b];
+
+        const int aHB = sign(orient2d(qb1, qb, pa));    // конец ребра P относительно ребра Q
+        const int bHA = sign(orient2d(pa1, pa, qb));    // конец ребра Q относительно ребра P
+        const int a1HB = sign(orient2d(qb1, qb, pa1));
+        const int b1HA = sign(orient2d(pa1, pa, qb1));
+        if (aHB == 0 || bHA == 0 || a1HB == 0 || b1HA == 0) return false;
+
+        // Знак поворота от направления ребра P к направлению ребра Q
+        const Point A = pa - pa1, B = qb - qb1;
+        const double t1 = A.x * B.y, t2 = A.y * B.x;
+        const double turn = t1 - t2;
+        if (turn != 0 && std::fabs(turn) <= 4 * std::numeric_limits<double>::epsilon() * (std::fabs(t1) + std::fabs(t2)))
+            return false;
+
+        if (aHB != a1HB && bHA != b1HA) {
+            // Собственное пересечение ребер: граница меняет, кто внутри
+            Point I;
+            if (!segmentIntersectProper(pa1, pa, qb1, qb, I)) return false;
+            if (inflag == Inside::Unknown) aa = ba = 0;   // обход считается от первой точки пересечения
+            out.push_back(I);
+            inflag = aHB > 0 ? Inside::P : Inside::Q;
+        }
+
+        if (turn == 0 && aHB < 0 && bHA < 0) {
+            out.clear();   // параллельные ребра смотрят друг от друга - многоугольники не пересекаются
+            return true;
+        }
+        const bool advanceP = turn >= 0 ? bHA > 0 : aHB < 0;
+        if (advanceP) {
+            if (inflag == Inside::P) out.push_back(pa);
+            a = (a + 1) % n;
+            ++aa;
+        } else {
+            if (inflag == Inside::Q) out.push_back(qb);
+            b = (b + 1) % m;
+            ++ba;
+        }
+    } while ((aa < n || ba < m) && aa < 2 * n && ba < 2 * m);
+
+    if (inflag == Inside::Unknown) {
+        // Границы не пересекаются: один многоугольник внутри другого или они не пересекаются
+        auto strictlyInside = [](const Polygon& poly, const Point& p, bool& degenerate) {
+            bool inside = true;
+            for (size_t i = 0; i < poly.size(); ++i) {
+                const int side = sign(orient2d(poly[i], poly[(i+1) % poly.size()], p));
+                degenerate |= side == 0;
+                inside &= side > 0;
+            }
+            return inside;
+        };
+        bool degenerate = false;
+        if (strictlyInside(Q, P[0], degenerate)) out = P;
+        else if (strictlyInside(P, Q[0], degenerate)) out = Q;
+        return !degenerate;
+    }
+
+    // Первая точка пересечения находится повторно в конце обхода
+    auto same = [](const Point& p, const Point& q) { return p.x == q.x && p.y == q.y; };
+    out.erase(std::unique(out.begin(), out.end(), same), out.end());
+    while (out.size() > 1 && same(out.front(), out.back())) out.pop_back();
+    return out.size() >= 3;
+}
+
 Polygon intersectConvex(const Polygon& subject, const Polygon& clip) {
     if (subject.empty() || clip.empty()) return {};
-    Polygon poly = subject;
-    const int m = (int)clip.size();
-    for (int i = 0; i < m && !poly.empty(); ++i) {
-        const Point& A = clip[i];
-        const Point& B = clip[(i+1)%m];
-        poly = clipHalfPlane(poly, A, B, /*keepLeft=*/true);
-    }
-    return poly;
+    Polygon result;
+    if (strictlyConvexCCW(subject) && strictlyConvexCCW(clip) && intersectConvexLinear(subject, clip, result))
+        return result;
+
+    ClipPipeline pipeline;
+    return pipeline.clipByPolygon(subject, clip, /*keepLeft=*/true);
 }
 
 Polygon differenceConvex(const Polygon& A, const Polygon& B) {
     if (A.empty()) return {};
     if (B.empty()) return A;
-    Polygon poly = A;
-    const int m = (int)B.size();
-    for (int i = 0; i < m && !poly.empty(); ++i) {
-        const Point& P = B[i];
-        const Point& Q = B[(i+1)%m];
-        poly = clipHalfPlane(poly, P, Q, /*keepLeft=*/false); 
-    }
-    return poly;
+    ClipPipeline pipeline;
+    return pipeline.clipByPolygon(A, B, /*keepLeft=*/false);
 }
 
-std::vector<Polygon> unionConvexDecomposed(const Polygon& A, const Polygon& B) {
-    std::vector<Polygon> parts;
-    Polygon AminusB = differenceConvex(A, B);
-    if (!AminusB.empty()) parts.push_back(std::move(AminusB));
+// Есть ли у многоугольника площадь: все треугольники веера из первой вершины
+// вырождены, только если все вершины лежат на одной прямой
+static bool hasArea(const Polygon& P) {
+    for (size_t i = 1; i + 1 < P.size(); ++i)
+        if (orient2d(P[0], P[i], P[i + 1]) != 0) return true;
+    return false;
+}
 
-    Polygon BminusA = differenceConvex(B, A);
-    if (!BminusA.empty()) parts.push_back(std::move(BminusA));
+std::vector<Polygon> differenceConvexDecomposed(const Polygon& A, const Polygon& B) {
+    std::vector<Polygon> parts;
+    if (!hasArea(A)) return parts;
+    if (!hasArea(B)) {
+        parts.push_back(A);
+        return parts;
+    }
 
-    Polygon I = intersectConvex(A, B);
-    if (!I.empty()) parts.push_back(std::move(I));
+    // Кусок i - часть A справа от ребра i и слева от ребер 0..i-1. Куски не
+    // пересекаются, а вместе покрывают все, что не лежит слева от всех ребер B
+    const size_t m = B.size();
+    Polygon rest = A, inside, piece;
+    for (size_t i = 0; i < m && hasArea(rest); ++i) {
+        HalfPlane edge{B[i], B[(i + 1) % m], /*keepLeft=*/false};
+        clipHalfPlane(rest, edge, piece);
+        if (hasArea(piece)) parts.push_back(piece);
+        edge.keepLeft = true;
+        clipHalfPlane(rest, edge, inside);
+        rest.swap(inside);
+    }
+    return parts;
+}
 
-    return parts; 
+std::vector<Polygon> unionConvexDecomposed(const Polygon& A, const Polygon& B) {
+    std::vector<Polygon> parts = differenceConvexDecomposed(A, B);
+    if (!B.empty()) parts.push_back(B);
+    return parts;
 }
 
 bool pointInConvex(const Polygon& poly, const Point& p) {
     const int n = (int)poly.size();
     if (n < 3) return false;
     for (int i = 0; i < n; ++i) {
-        if (cross(poly[i], poly[(i+1)%n], p) < -1e-12) return false;
+        if (orient2d(poly[i], poly[(i+1)%n], p) < 0) return false;
     }
     return true;
 }
 
+// Отрезки ab и cd (возможно, вырожденные в точку) имеют общую точку
+static bool segmentsTouch(const Point& a, const Point& b, const Point& c, const Point& d) {
+    const double o1 = orient2d(a, b, c), o2 = orient2d(a, b, d);
+    const double o3 = orient2d(c, d, a), o4 = orient2d(c, d, b);
+    if (((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) && ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0)))
+        return true;
+    // r на прямой pq: лежит ли в пределах отрезка
+    auto within = [](const Point& p, const Point& q, const Point& r) {
+        return std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x) &&
+               std::min(p.y, q.y) <= r.y && r.y <= std::max(p.y, q.y);
+    };
+    return (o1 == 0 && within(a, b, c)) || (o2 == 0 && within(a, b, d)) ||
+           (o3 == 0 && within(c, d, a)) || (o4 == 0 && within(c, d, b));
+}
+
+// Разделяет ли многоугольники прямая одного из ребер P: все вершины Q строго
+// справа от него. Для каждого ребра проверяется вершина Q, дальше всех
+// отстоящая влево; при обходе ребер P против часовой она тоже движется против
+// часовой, так что все ребра проверяются за O(n + m). Вершина выбирается
+// в double, поэтому найденная ось подтверждается точным предикатом по всем
+// вершинам Q - это происходит не больше раза, если ось действительно есть
+static bool separatedByEdgeOf(const Polygon& P, const Polygon& Q) {
+    const size_t n = P.size(), m = Q.size();
+    size_t j = 0;
+    const Point first = P[1] - P[0];
+    for (size_t k = 1; k < m; ++k)
+        if (cross(first, Q[k]) > cross(first, Q[j])) j = k;
+
+    for (size_t i = 0; i < n; ++i) {
+        const Point& A = P[i];
+        const Point& B = P[(i+1) % n];
+        const Point e = B - A;
+        for (size_t step = 0; step < m && cross(e, Q[(j+1) % m] - Q[j]) >= 0; ++step) j = (j+1) % m;
+        if (orient2d(A, B, Q[j]) >= 0) continue;
+
+        size_t k = 0;
+        while (k < m && orient2d(A, B, Q[k]) < 0) ++k;
+        if (k == m) return true;
+        j = k;
+    }
+    return false;
+}
+
+// Многоугольник меньше чем из трех вершин против произвольного выпуклого
+static bool degenerateOverlap(const Polygon& S, const Polygon& P) {
+    if (P.size() >= 3 && pointInConvex(P, S[0])) return true;
+    const size_t k = S.size(), n = P.size();
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < n; ++j)
+            if (segmentsTouch(S[i], S[(i+1) % k], P[j], P[(j+1) % n])) return true;
+    return false;
+}
+
+bool convexOverlap(const Polygon& A, const Polygon& B) {
+    if (A.empty() || B.empty()) return false;
+    if (A.size() < 3) return degenerateOverlap(A, B);
+    if (B.size() < 3) return degenerateOverlap(B, A);
+    return !separatedByEdgeOf(A, B) && !separatedByEdgeOf(B, A);
+}
+
+// Квадрат расстояния от начала координат до отрезка pq
+static double distance2ToSegment(const Point& p, const Point& q) {
+    const Point d = q - p;
+    const double length2 = dot(d, d);
+    double t = length2 > 0 ? std::clamp(-dot(p, d) / length2, 0.0, 1.0) : 0.0;
+    const Point closest{p.x + t*d.x, p.y + t*d.y};
+    return dot(closest, closest);
+}
+
+double convexDistance(const Polygon& A, const Polygon& B) {
+    if (A.empty() || B.empty()) return std::numeric_limits<double>::infinity();
+    if (convexOverlap(A, B)) return 0.0;
+
+    // Расстояние между многоугольниками - расстояние от начала координат до
+    // разности Минковского A - B. Ее ребра - ребра A и -B, слитые по углу,
+    // начиная с нижней вершины: это нижняя вершина A минус верхняя B.
+    // Вершины разности считаются по ходу слияния и нигде не хранятся
+    const size_t n = A.size(), m = B.size();
+    size_t ia = 0, ib = 0;
+    for (size_t i = 1; i < n; ++i)
+        if (A[i].y < A[ia].y || (A[i].y == A[ia].y && A[i].x < A[ia].x)) ia = i;
+    for (size_t j = 1; j < m; ++j)
+        if (B[j].y > B[ib].y || (B[j].y == B[ib].y && B[j].x > B[ib].x)) ib = j;
+    auto vertex = [&](size_t i, size_t j) { return A[(ia + i) % n] - B[(ib + j) % m]; };
+    auto edgeA = [&](size_t i) { return A[(ia + i + 1) % n] - A[(ia + i) % n]; };
+    auto edgeB = [&](size_t j) { return B[(ib + j) % m] - B[(ib + j + 1) % m]; };
+
+    double best = std::numeric_limits<double>::infinity();
+    size_t i = 0, j = 0;
+    while (i < n || j < m) {
+        const Point from = vertex(i, j);
+        if (j == m) ++i;
+        else if (i == n) ++j;
+        else {
+            const double turn = cross(edgeA(i), edgeB(j));
+            if (turn >= 0) ++i;
+            if (turn <= 0) ++j;
+        }
+        best = std::min(best, distance2ToSegment(from, vertex(i, j)));
+    }
+    return std::sqrt(best);
+}
+
 static double signedArea(const Polygon& P) {
     double a = 0.0;
     const int n = (int)P.size();
@@ -0,0 +1,178 @@
+// booleanOp против поточечной проверки: случайная точка лежит в результате
+// тогда и только тогда, когда op(в A, в B) по правилу чет-нечет. Результат
+// должен быть без самопересечений, внешние контуры против часовой, дыры по
+// часовой - значит, индекс обхода результата в каждой точке 0 или 1.
+// Точки у ребер входа пропускаются: там принадлежность решает округление
+#include "plane_geometry/Boolean.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace PlaneGeometry;
+
+namespace {
+
+int failures = 0;
+
+bool evenOdd(const PolygonSet& set, const Point& p) {
+    bool inside = false;
+    for (const Polygon& poly : set) {
+        for (std::size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+            const Point& a = poly[i];
+            const Point& b = poly[j];
+            if ((a.y > p.y) != (b.y > p.y) &&
+                p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)
+                inside = !inside;
+        }
+    }
+    return inside;
+}
+
+int winding(const PolygonSet& set, const Point& p) {
+    int w = 0;
+    for (const Polygon& poly : set) {
+        for (std::size_t i = 0; i < poly.size(); ++i) {
+            const Point& a = poly[i];
+            const Point& b = poly[(i + 1) % poly.size()];
+            if (a.y <= p.y) {
+                if (b.y > p.y && cross(a, b, p) > 0) ++w;
+            } else if (b.y <= p.y && cross(a, b, p) < 0) {
+                --w;
+            }
+        }
+    }
+    return w;
+}
+
+double segmentDistance(const Point& p, const Point& a, const Point& b) {
+    Point ab = b - a;
+    double len2 = dot(ab, ab);
+    double t = len2 > 0 ? std::clamp(dot(p - a, ab) / len2, 0.0, 1.0) : 0.0;
+    return std::hypot(p.x - a.x - t * ab.x, p.y - a.y - t * ab.y);
+}
+
+bool nearEdge(const PolygonSet& set, const Point& p, double eps) {
+    for (const Polygon& poly : set)
+        for (std::size_t i = 0; i < poly.size(); ++i)
+            if (segmentDistance(p, poly[i], poly[(i + 1) % poly.size()]) < eps) return true;
+    return false;
+}
+
+bool expected(BooleanOp op, bool a, bool b) {
+    switch (op) {
+    case BooleanOp::Intersection: return a && b;
+    case BooleanOp::Union:        return a || b;
+    case BooleanOp::Difference:   return a && !b;
+    case BooleanOp::Xor:          return a != b;
+    }
+    return false;
+}
+
+const char* name(BooleanOp op) {
+    switch (op) {
+    case BooleanOp::Intersection: return "intersection";
+    case BooleanOp::Union:        return "union";
+    case BooleanOp::Difference:   return "difference";
+    case BooleanOp::Xor:          return "xor";
+    }
+    return "?";
+}
+
+// Звездный многоугольник: простой, но невыпуклый
+Polygon star(std::mt19937& rng, double cx, double cy, double radius, int n) {
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI), scale(0.2, 1.0);
+    std::vector<double> angles(n);
+    for (double& a : angles) a = angle(rng);
+    std::sort(angles.begin(), angles.end());
+    Polygon poly;
+    for (double a : angles) {
+        double r = radius * scale(rng);
+        poly.push_back({cx + r * std::cos(a), cy + r * std::sin(a)});
+    }
+    return poly;
+}
+
+// Вершины в случайном порядке: самопересечения почти наверняка
+Polygon scribble(std::mt19937& rng, double size, int n) {
+    std::uniform_real_distribution<double> coord(0, size);
+    Polygon poly;
+    for (int i = 0; i < n; ++i) poly.push_back({coord(rng), coord(rng)});
+    return poly;
+}
+
+// Целые координаты на маленькой решетке: общие вершины, наложенные ребра
+Polygon grid(std::mt19937& rng, int size, int n) {
+    std::uniform_int_distribution<int> coord(0, size);
+    Polygon poly;
+    for (int i = 0; i < n; ++i) poly.push_back({double(coord(rng)), double(coord(rng))});
+    return poly;
+}
+
+void check(const char* kind, int index, const PolygonSet& a, const PolygonSet& b,
+           std::mt19937& rng) {
+    std::uniform_real_distribution<double> coord(-1, 11);
+    for (BooleanOp op : {BooleanOp::Intersection, BooleanOp::Union, BooleanOp::Difference,
+                         BooleanOp::Xor}) {
+        PolygonSet result = booleanOp(a, b, op);
+        for (const Polygon& poly : result) {
+            if (poly.size() < 3) {
+                std::printf("%s #%d %s: contour with %zu vertices\n", kind, index, name(op),
+                            poly.size());
+                ++failures;
+                return;
+            }
+        }
+        for (int s = 0; s < 300; ++s) {
+            Point p{coord(rng), coord(rng)};
+            if (nearEdge(a, p, 1e-7) || nearEdge(b, p, 1e-7)) continue;
+            bool want = expected(op, evenOdd(a, p), evenOdd(b, p));
+            int w = winding(result, p);
+            if (w != (want ? 1 : 0)) {
+                std::printf("%s #%d %s: winding %d at (%.17g, %.17g), expected %d\n", kind,
+                            index, name(op), w, p.x, p.y, want ? 1 : 0);
+                ++failures;
+                return;
+            }
+        }
+    }
+}
+
+}
+
+int main() {
+    std::mt19937 rng(12345);
+
+    for (int i = 0; i < 300; ++i) {
+        std::uniform_int_distribution<int> n(3, 12);
+        check("star", i, {star(rng, 4, 5, 4, n(rng))}, {star(rng, 6, 5, 4, n(rng))}, rng);
+    }
+    for (int i = 0; i < 300; ++i) {
+        std::uniform_int_distribution<int> n(3, 9);
+        check("self-intersecting", i, {scribble(rng, 10, n(rng))}, {scribble(rng, 10, n(rng))},
+              rng);
+    }
+    for (int i = 0; i < 500; ++i) {
+        std::uniform_int_distribution<int> n(3, 7);
+        check("grid", i, {grid(rng, 10, n(rng))}, {grid(rng, 10, n(rng))}, rng);
+    }
+    for (int i = 0; i < 200; ++i) {
+        // Несколько контуров и дыра: внутренняя звезда в большой
+        PolygonSet a{star(rng, 5, 5, 5, 10), star(rng, 5, 5, 1, 6)};
+        PolygonSet b{star(rng, 2, 2, 2, 7), star(rng, 8, 8, 2, 7), grid(rng, 10, 4)};
+        check("multi-contour", i, a, b, rng);
+    }
+    for (int i = 0; i < 100; ++i) {
+        // Совпадающие входы: все ребра наложены
+        Polygon a = i % 2 ? grid(rng, 10, 6) : star(rng, 5, 5, 5, 8);
+        check("identical", i, {a}, {a}, rng);
+    }
+
+    if (failures) {
+        std::printf("%d failures\n", failures);
+        return 1;
+    }
+    std::printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Запросы к выпуклым многоугольникам против перебора: intersectConvex -
+// против цепочки clipHalfPlane по ребрам B, convexOverlap - против проверки
+// всех пар ребер и вершин, convexDistance - против минимума по парам ребер.
+// Решетка с целыми координатами дает касания, общие ребра и вырожденные входы
+#include "plane_geometry/Geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+using namespace PlaneGeometry;
+
+namespace {
+
+int failures = 0;
+
+double area(const Polygon& poly) {
+    double s = 0;
+    for (std::size_t i = 0; i < poly.size(); ++i) s += cross(poly[i], poly[(i + 1) % poly.size()]);
+    return s / 2;
+}
+
+Polygon clipChain(const Polygon& a, const Polygon& b) {
+    Polygon result = a;
+    for (std::size_t i = 0; i < b.size() && !result.empty(); ++i)
+        result = clipHalfPlane(result, b[i], b[(i + 1) % b.size()], true);
+    return result;
+}
+
+int sign(double v) { return (v > 0) - (v < 0); }
+
+bool onSegment(const Point& p, const Point& a, const Point& b) {
+    return cross(a, b, p) == 0 && std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+bool segmentsIntersect(const Point& a, const Point& b, const Point& c, const Point& d) {
+    int d1 = sign(cross(a, b, c)), d2 = sign(cross(a, b, d));
+    int d3 = sign(cross(c, d, a)), d4 = sign(cross(c, d, b));
+    if (d1 * d2 < 0 && d3 * d4 < 0) return true;
+    return onSegment(c, a, b) || onSegment(d, a, b) || onSegment(a, c, d) || onSegment(b, c, d);
+}
+
+// Точка внутри или на границе: все повороты неотрицательны
+bool inside(const Polygon& poly, const Point& p) {
+    if (poly.size() < 3) return false;
+    for (std::size_t i = 0; i < poly.size(); ++i)
+        if (cross(poly[i], poly[(i + 1) % poly.size()], p) < 0) return false;
+    return true;
+}
+
+// Ребра многоугольника; у точки одно вырожденное ребро
+std::vector<std::pair<Point, Point>> edges(const Polygon& poly) {
+    std::vector<std::pair<Point, Point>> result;
+    if (poly.size() == 1) result.push_back({poly[0], poly[0]});
+    if (poly.size() == 2) result.push_back({poly[0], poly[1]});
+    if (poly.size() >= 3)
+        for (std::size_t i = 0; i < poly.size(); ++i)
+            result.push_back({poly[i], poly[(i + 1) % poly.size()]});
+    return result;
+}
+
+bool bruteOverlap(const Polygon& a, const Polygon& b) {
+    if (a.empty() || b.empty()) return false;
+    if (inside(a, b[0]) || inside(b, a[0])) return true;
+    for (const auto& [p, q] : edges(a))
+        for (const auto& [r, s] : edges(b))
+            if (segmentsIntersect(p, q, r, s)) return true;
+    return false;
+}
+
+double pointSegment(const Point& p, const Point& a, const Point& b) {
+    Point ab = b - a;
+    double len2 = dot(ab, ab);
+    double t = len2 > 0 ? std::clamp(dot(p - a, ab) / len2, 0.0, 1.0) : 0.0;
+    return std::hypot(p.x - a.x - t * ab.x, p.y - a.y - t * ab.y);
+}
+
+double bruteDistance(const Polygon& a, const Polygon& b) {
+    if (a.empty() || b.empty()) return std::numeric_limits<double>::infinity();
+    if (bruteOverlap(a, b)) return 0;
+    double best = std::numeric_limits<double>::infinity();
+    for (const auto& [p, q] : edges(a))
+        for (const auto& [r, s] : edges(b))
+            best = std::min({best, pointSegment(p, r, s), pointSegment(q, r, s),
+                             pointSegment(r, p, q), pointSegment(s, p, q)});
+    return best;
+}
+
+Polygon randomHull(std::mt19937& rng, double cx, double cy, double radius, int n) {
+    std::uniform_real_distribution<double> offset(-radius, radius);
+    std::vector<Point> pts;
+    for (int i = 0; i < n; ++i) pts.push_back({cx + offset(rng), cy + offset(rng)});
+    return convexHull(pts);
+}
+
+Polygon gridHull(std::mt19937& rng, int size, int n) {
+    std::uniform_int_distribution<int> coord(0, size);
+    std::vector<Point> pts;
+    for (int i = 0; i < n; ++i) pts.push_back({double(coord(rng)), double(coord(rng))});
+    return convexHull(pts);
+}
+
+void check(const char* kind, int index, const Polygon& a, const Polygon& b) {
+    if (a.size() >= 3 && b.size() >= 3) {
+        Polygon fast = intersectConvex(a, b);
+        Polygon slow = clipChain(a, b);
+        double scale = std::max(1.0, std::abs(area(a)));
+        if (std::abs(area(fast) - std::abs(area(slow))) > 1e-9 * scale || area(fast) < 0) {
+            std::printf("%s #%d: intersectConvex area %.17g, clipping chain %.17g\n", kind, index,
+                        area(fast), area(slow));
+            ++failures;
+        }
+        for (const Point& p : fast) {
+            if (!inside(a, p) || !inside(b, p)) {
+                // Вершина пересечения может отойти от границ на округление
+                bool near = false;
+                for (const auto& [r, s] : edges(a)) near |= pointSegment(p, r, s) < 1e-9 * scale;
+                for (const auto& [r, s] : edges(b)) near |= pointSegment(p, r, s) < 1e-9 * scale;
+                if (!near) {
+                    std::printf("%s #%d: intersectConvex vertex (%.17g, %.17g) outside A and B\n", kind,
+                                index, p.x, p.y);
+                    ++failures;
+                    break;
+                }
+            }
+        }
+    }
+
+    bool overlap = convexOverlap(a, b);
+    if (overlap != bruteOverlap(a, b)) {
+        std::printf("%s #%d: convexOverlap %d, brute force %d\n", kind, index, overlap, !overlap);
+        ++failures;
+    }
+    double distance = convexDistance(a, b), expected = bruteDistance(a, b);
+    if (!(std::abs(distance - expected) <= 1e-9 * std::max(1.0, expected)) &&
+        !(std::isinf(distance) && std::isinf(expected))) {
+        std::printf("%s #%d: convexDistance %.17g, brute force %.17g\n", kind, index, distance,
+                    expected);
+        ++failures;
+    }
+}
+
+}
+
+int main() {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> centre(0, 10);
+    std::uniform_int_distribution<int> count(1, 40);
+
+    for (int i = 0; i < 3000; ++i) {
+        Polygon a = randomHull(rng, centre(rng), centre(rng), 3, count(rng));
+        Polygon b = randomHull(rng, centre(rng), centre(rng), 3, count(rng));
+        check("random", i, a, b);
+    }
+    for (int i = 0; i < 3000; ++i) {
+        std::uniform_int_distribution<int> n(1, 8);
+        check("grid", i, gridHull(rng, 6, n(rng)), gridHull(rng, 6, n(rng)));
+    }
+    for (int i = 0; i < 300; ++i) {
+        // Много вершин: сотни, как у реальных оболочек
+        std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+        std::vector<Point> pa, pb;
+        double shift = 4 + centre(rng) * 0.4;
+        for (int k = 0; k < 400; ++k) {
+            double t = angle(rng), u = angle(rng);
+            pa.push_back({4 + 3 * std::cos(t), 5 + 3 * std::sin(t)});
+            pb.push_back({shift + 3 * std::cos(u), 5 + 3 * std::sin(u)});
+        }
+        check("circles", i, convexHull(pa), convexHull(pb));
+    }
+    check("empty", 0, Polygon{}, gridHull(rng, 6, 5));
+
+    if (failures) {
+        std::printf("%d failures\n", failures);
+        return 1;
+    }
+    std::printf("ok\n");
+    return 0;
+}
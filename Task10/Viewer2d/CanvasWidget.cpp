@@ -22,6 +22,7 @@ CanvasWidget::CanvasWidget(QWidget* parent)
 
 void CanvasWidget::setOp(Op op) {
     m_op = op;
+    updateResult();
     update();
 }
 
@@ -37,6 +38,7 @@ void CanvasWidget::finalizeSecond() {
     if (m_polyB.size() >= 3) {
         m_closedB = true;
         m_phase   = Phase::Ready;
+        updateResult();
         update();
     }
 }
@@ -50,6 +52,7 @@ void CanvasWidget::clearAll() {
     m_dragInA   = true;
     m_dragIndex = -1;
     m_phase     = Phase::EditingFirst;
+    m_resultPath = QPainterPath();
     update();
 }
 
@@ -96,6 +99,31 @@ QPainterPath CanvasWidget::pathFromPoly(const Polygon& poly, bool closed) const
     return path;
 }
 
+QPainterPath CanvasWidget::pathFromPolygons(const PlaneGeometry::PolygonSet& polygons) const {
+    // Дыры идут отдельными контурами по часовой, правило чет-нечет их вырезает.
+    // У самопересекающегося входа booleanOp тоже берет чет-нечет, так что
+    // области, обойденные дважды, в результат не попадают, хотя заливка
+    // входного контура их закрашивает
+    QPainterPath path;
+    for (const Polygon& poly : polygons)
+        path.addPath(pathFromPoly(poly, true));
+    path.setFillRule(Qt::OddEvenFill);
+    return path;
+}
+
+void CanvasWidget::updateResult() {
+    m_resultPath = QPainterPath();
+    if (!m_closedA || !m_closedB) return;
+
+    PlaneGeometry::BooleanOp op = PlaneGeometry::BooleanOp::Intersection;
+    switch (m_op) {
+    case Op::Intersect:  op = PlaneGeometry::BooleanOp::Intersection; break;
+    case Op::Union:      op = PlaneGeometry::BooleanOp::Union; break;
+    case Op::Difference: op = PlaneGeometry::BooleanOp::Difference; break;
+    }
+    m_resultPath = pathFromPolygons(PlaneGeometry::booleanOp(m_polyA, m_polyB, op));
+}
+
 void CanvasWidget::paintEvent(QPaintEvent* /*event*/) {
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
@@ -181,64 +209,30 @@ void CanvasWidget::paintEvent(QPaintEvent* /*event*/) {
 
     // 3. Выполняем булевы операции только если оба полигона замкнуты
     if (m_closedA && m_closedB) {
-        QPainterPath pathA = pathFromPoly(m_polyA, true);
-        QPainterPath pathB = pathFromPoly(m_polyB, true);
-
-        QPainterPath resultPath;
+        const QPainterPath& resultPath = m_resultPath;
         QColor resultColor;
         QString operationText;
 
         if (m_op == Op::Intersect) {
-            resultPath = pathA.intersected(pathB);
             resultColor = QColor(255, 100, 100, 200); // Красный для пересечения
             operationText = "Пересечение";
-
-            // Рисуем результат пересечения
-            if (!resultPath.isEmpty()) {
-                p.setPen(QPen(resultColor.darker(), 4));
-                p.setBrush(QBrush(resultColor));
-                p.drawPath(resultPath);
-            }
         } else if (m_op == Op::Union) {
-            resultPath = pathA.united(pathB);
             resultColor = QColor(100, 200, 100, 200); // Зеленый для объединения
             operationText = "Объединение";
-
-            // Рисуем результат объединения
-            if (!resultPath.isEmpty()) {
-                p.setPen(QPen(resultColor.darker(), 4));
-                p.setBrush(QBrush(resultColor));
-                p.drawPath(resultPath);
-            }
-        } else if (m_op == Op::Difference) {
-            // Для разности (A - B) вырезаем часть B из A белым цветом
-            resultPath = pathA.subtracted(pathB);
+        } else {
+            resultColor = QColor(230, 120, 30, 200);  // Темно-оранжевый для разности
             operationText = "Разность (A - B)";
+        }
 
-            // Сначала рисуем полигон A полностью
-            p.setPen(QPen(polyAColor, 3));
-            p.setBrush(QBrush(polyAFill));
-            p.drawPath(pathA);
-
-            // Находим пересечение A и B
-            QPainterPath intersectPath = pathA.intersected(pathB);
-
-            // Пересечение рисуем БЕЛЫМ цветом (вырезаем)
-            if (!intersectPath.isEmpty()) {
-                p.setPen(QPen(Qt::white, 3));
-                p.setBrush(QBrush(Qt::white));
-                p.drawPath(intersectPath);
-
-                // Контур вырезанной области - пунктир
-                QPen dashPen(QColor(150, 150, 150), 2, Qt::DashLine);
-                p.setPen(dashPen);
-                p.setBrush(Qt::NoBrush);
-                p.drawPath(intersectPath);
-            }
+        // Рисуем результат операции, посчитанный в updateResult
+        if (!resultPath.isEmpty()) {
+            p.setPen(QPen(resultColor.darker(), 4));
+            p.setBrush(QBrush(resultColor));
+            p.drawPath(resultPath);
         }
 
-        // Подписываем результат (для всех операций кроме разности)
-        if (m_op != Op::Difference && !resultPath.isEmpty() && !resultPath.boundingRect().isEmpty()) {
+        // Подписываем результат
+        if (!resultPath.isEmpty() && !resultPath.boundingRect().isEmpty()) {
             QRectF bounds = resultPath.boundingRect();
             p.setPen(Qt::black);
             p.setFont(QFont("Arial", 12, QFont::Bold));
@@ -258,30 +252,6 @@ void CanvasWidget::paintEvent(QPaintEvent* /*event*/) {
             p.setPen(resultColor.darker());
             p.drawText(operationRect, Qt::AlignCenter, operationText);
         }
-
-        // Для разности подписываем отдельно
-        if (m_op == Op::Difference) {
-            // Находим подходящее место для надписи (центр полигона A)
-            if (!pathA.boundingRect().isEmpty()) {
-                QRectF bounds = pathA.boundingRect();
-                p.setPen(Qt::black);
-                p.setFont(QFont("Arial", 12, QFont::Bold));
-
-                QFont operationFont("Arial", 12, QFont::Bold);
-                QFontMetrics operationFm(operationFont);
-                int operationWidth = operationFm.horizontalAdvance(operationText);
-                QRect operationRect(bounds.center().x() - operationWidth/2 - 10,
-                                    bounds.center().y() - 20,
-                                    operationWidth + 20, 25);
-
-                p.setPen(Qt::NoPen);
-                p.setBrush(QColor(255, 255, 255, 220));
-                p.drawRoundedRect(operationRect, 5, 5);
-
-                p.setPen(polyAColor.darker());
-                p.drawText(operationRect, Qt::AlignCenter, operationText);
-            }
-        }
     }
 
     // 4. Рисуем легенду в правом нижнем углу
@@ -360,6 +330,7 @@ void CanvasWidget::mouseMoveEvent(QMouseEvent* event) {
             if (m_dragIndex >= 0 && m_dragIndex < (int)m_polyB.size())
                 m_polyB[m_dragIndex] = p;
         }
+        updateResult();
         update();
     }
 
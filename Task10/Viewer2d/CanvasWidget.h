@@ -1,7 +1,8 @@
 #pragma once
+#include <QPainterPath>
 #include <QWidget>
 #include <vector>
-#include "plane_geometry/Geometry.h"
+#include "plane_geometry/Boolean.h"
 
 class CanvasWidget : public QWidget {
     Q_OBJECT
@@ -42,7 +43,13 @@ private:
 
     double m_hitRadiusPx{8.0};
 
+    // Результат операции пересчитывается при правке, а не при каждой
+    // перерисовке. Для разности здесь пересечение - вырезаемая из A часть
+    QPainterPath m_resultPath;
+
     void addPointForCurrent(const QPointF& pos);
     bool pickVertex(const QPointF& pos);
     QPainterPath pathFromPoly(const Polygon& poly, bool closed) const;
+    QPainterPath pathFromPolygons(const PlaneGeometry::PolygonSet& polygons) const;
+    void updateResult();
 };
@@ -6,7 +6,25 @@ enum class PointPosition { Inside, Outside, OnBoundary, NearBoundary };
 
 class Geometry {
 public:
-    static std::vector<Point> convexHull(std::vector<Point> points);
+    // cullInterior - отсечь внутренние точки перед сортировкой (на результат не влияет);
+    // в culled - сколько точек отсечено
+    static std::vector<Point> convexHull(std::vector<Point> points, bool cullInterior = true,
+                                         std::size_t *culled = nullptr);
+    // То же без выделения памяти: points[0..n) - рабочий буфер (порядок и
+    // содержимое портятся), hull - место минимум под n + 1 точку.
+    // Возвращает число вершин оболочки, записанных в hull
+    static std::size_t convexHull(Point *points, std::size_t n, Point *hull, bool cullInterior = true,
+                                  std::size_t *culled = nullptr);
+    // Удаляет точки внутри восьмиугольника Акла-Туссена, возвращает их число
+    static std::size_t cullInteriorPoints(std::vector<Point> &points);
+    // То же на месте: оставшиеся точки сдвигаются в начало points[0..n)
+    static std::size_t cullInteriorPoints(Point *points, std::size_t n);
+    // Чинит оболочку hull (результат convexHull) после переноса одной точки из
+    // oldPos в newPos; points уже содержит точку в новом положении. Пересчет
+    // нужен, только если вершина оболочки ушла внутрь, и затрагивает лишь точки
+    // в освободившемся "кармане" между ее соседями
+    static void updateConvexHull(std::vector<Point> &hull, const std::vector<Point> &points,
+                                 const Point &oldPos, const Point &newPos);
     static PointPosition pointInPolygon(const Point &p, const std::vector<Point> &polygon, double delta);
     static double minDistance(const std::vector<Point> &polygon);
 };
@@ -1,35 +1,229 @@
 #include "PlaneGeometry/Geometry.h"
+#include "PlaneGeometry/Predicates.h"
+#include "PlaneGeometry/RadixSort.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 using namespace std;
 
+// ------------------ отсечение Акла-Туссена ------------------
+// Точки строго внутри восьмиугольника из крайних точек по x, y, x+y и x-y
+// не могут быть вершинами оболочки и удаляются до сортировки
+namespace {
+const size_t CullMinPoints = 64;     // на меньших наборах проход не окупается
+const size_t CullBlock = 1024;
+// Оценка погрешности векторного произведения в double (по Шевчуку) с запасом
+const double CullEpsilon = std::numeric_limits<double>::epsilon() / 2;
+const double CullErrBound = 2 * (3.0 + 16.0 * CullEpsilon) * CullEpsilon;
+
+bool samePoint(const Point &a, const Point &b){ return a.x == b.x && a.y == b.y; }
+}
+
+size_t Geometry::cullInteriorPoints(Point *points, size_t n){
+    if(n < CullMinPoints) return 0;
+
+    // Крайние точки против часовой начиная с самой левой:
+    // min x, min x+y, min y, max x-y, max x, max x+y, max y, min x-y
+    size_t ext[8] = {};
+    for(size_t i = 1; i < n; ++i){
+        const Point &p = points[i];
+        if(p.x < points[ext[0]].x) ext[0] = i;
+        if(p.x + p.y < points[ext[1]].x + points[ext[1]].y) ext[1] = i;
+        if(p.y < points[ext[2]].y) ext[2] = i;
+        if(p.x - p.y > points[ext[3]].x - points[ext[3]].y) ext[3] = i;
+        if(p.x > points[ext[4]].x) ext[4] = i;
+        if(p.x + p.y > points[ext[5]].x + points[ext[5]].y) ext[5] = i;
+        if(p.y > points[ext[6]].y) ext[6] = i;
+        if(p.x - p.y < points[ext[7]].x - points[ext[7]].y) ext[7] = i;
+    }
+
+    Point octagon[8];
+    size_t m = 0;
+    for(size_t k = 0; k < 8; ++k)
+        if(m == 0 || !samePoint(points[ext[k]], octagon[m-1])) octagon[m++] = points[ext[k]];
+    while(m > 1 && samePoint(octagon[m-1], octagon[0])) --m;
+    if(m < 3) return 0;
+
+    // Недостающие до восьми ребра повторяют последнее - внутренний цикл разворачивается
+    double ax[8], ay[8], dx[8], dy[8];
+    for(size_t k = 0; k < 8; ++k){
+        size_t j = std::min(k, m-1);
+        ax[k] = octagon[j].x;
+        ay[k] = octagon[j].y;
+        dx[k] = octagon[(j+1) % m].x - octagon[j].x;
+        dy[k] = octagon[(j+1) % m].y - octagon[j].y;
+    }
+
+    // Запас над оценкой погрешности по всем ребрам без ветвлений (векторизуется),
+    // затем оставшиеся точки уплотняются на месте
+    double margin[CullBlock];
+    size_t kept = 0;
+    for(size_t begin = 0; begin < n; begin += CullBlock){
+        const size_t count = std::min(CullBlock, n - begin);
+        const Point *block = points + begin;
+        for(size_t i = 0; i < count; ++i){
+            double least = std::numeric_limits<double>::infinity();
+            for(size_t k = 0; k < 8; ++k){
+                double t1 = dx[k] * (block[i].y - ay[k]);
+                double t2 = dy[k] * (block[i].x - ax[k]);
+                least = std::min(least, t1 - t2 - CullErrBound * (std::fabs(t1) + std::fabs(t2)));
+            }
+            margin[i] = least;
+        }
+        for(size_t i = 0; i < count; ++i){
+            points[kept] = block[i];
+            kept += !(margin[i] > 0);
+        }
+    }
+    return n - kept;
+}
+
+size_t Geometry::cullInteriorPoints(std::vector<Point> &points){
+    size_t removed = cullInteriorPoints(points.data(), points.size());
+    points.resize(points.size() - removed);
+    return removed;
+}
+
 // Алгоритм Грэхема / сортировка по углу и выпуклая оболочка
-vector<Point> Geometry::convexHull(vector<Point> points) {
-    if(points.size() <= 3) return points;
-    sort(points.begin(), points.end(), [](const Point &a, const Point &b){
-        return a.x < b.x || (a.x == b.x && a.y < b.y);
-    });
+size_t Geometry::convexHull(Point *points, size_t n, Point *hull, bool cullInterior, size_t *culled) {
+    if(culled) *culled = 0;
+    if(n <= 3){
+        copy(points, points + n, hull);
+        return n;
+    }
+    if(cullInterior){
+        size_t removed = cullInteriorPoints(points, n);
+        n -= removed;
+        if(culled) *culled = removed;
+    }
+    // Выходной буфер до построения оболочки служит рабочим для сортировки
+    radixSortByPoint(points, n, hull, [](const Point &p) -> const Point & { return p; });
 
-    vector<Point> hull;
+    size_t k = 0;
     // Нижняя
-    for(auto &p: points) {
-        while(hull.size() >= 2 && ((hull.back()-hull[hull.size()-2]).cross(p-hull.back())) <= 0)
-            hull.pop_back();
-        hull.push_back(p);
+    for(size_t i = 0; i < n; ++i){
+        const Point &p = points[i];
+        while(k >= 2 && orient2d(hull[k-2], hull[k-1], p) <= 0)
+            --k;
+        hull[k++] = p;
     }
     // Верхняя
-    size_t t = hull.size() + 1;
-    for(int i = points.size()-2; i>=0; --i){
-        auto &p = points[i];
-        while(hull.size() >= t && ((hull.back()-hull[hull.size()-2]).cross(p-hull.back())) <=0)
-            hull.pop_back();
-        hull.push_back(p);
+    size_t t = k + 1;
+    for(int i = (int)n-2; i>=0; --i){
+        const Point &p = points[i];
+        while(k >= t && orient2d(hull[k-2], hull[k-1], p) <= 0)
+            --k;
+        hull[k++] = p;
     }
-    hull.pop_back();
+    return k - 1;
+}
+
+vector<Point> Geometry::convexHull(vector<Point> points, bool cullInterior, size_t *culled) {
+    vector<Point> hull(points.size() + 1);
+    hull.resize(convexHull(points.data(), points.size(), hull.data(), cullInterior, culled));
     return hull;
 }
 
+// ------------------ починка оболочки при переносе точки ------------------
+namespace {
+// > 0 - поворот o -> a -> b налево; знак точный, как и в convexHull
+double turn(const Point &o, const Point &a, const Point &b){ return orient2d(o, a, b); }
+
+// Начало оболочки - лексикографически наименьшая вершина, как у convexHull
+void startAtLowest(vector<Point> &hull){
+    auto lowest = min_element(hull.begin(), hull.end(), [](const Point &a, const Point &b){
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    rotate(hull.begin(), lowest, hull.end());
+}
+
+// Добавляет p к выпуклому многоугольнику против часовой (не меньше трех вершин).
+// Видимые из p ребра идут подряд; вершины внутри этой цепочки удаляются.
+// false - если из-за округления видимы все ребра
+bool insertHullPoint(vector<Point> &hull, const Point &p){
+    const size_t h = hull.size();
+    bool outside = false;
+    vector<char> visible(h);
+    for(size_t i = 0; i < h; ++i){
+        double t = turn(hull[i], hull[(i+1)%h], p);
+        visible[i] = t <= 0;     // коллинеарное ребро рядом с видимыми тоже уходит
+        outside |= t < 0;
+    }
+    if(!outside) return true;
+
+    size_t first = 0;
+    while(first < h && !(visible[first] && !visible[(first+h-1)%h])) ++first;
+    if(first == h) return false;
+    size_t last = first;
+    while(visible[(last+1)%h]) last = (last+1)%h;
+
+    // Остаются вершины от конца видимой цепочки до ее начала, затем p
+    vector<Point> result;
+    result.reserve(h + 1);
+    for(size_t i = (last+1)%h; ; i = (i+1)%h){
+        result.push_back(hull[i]);
+        if(i == first) break;
+    }
+    result.push_back(p);
+    hull.swap(result);
+    return true;
+}
+}
+
+void Geometry::updateConvexHull(vector<Point> &hull, const vector<Point> &points,
+                                const Point &oldPos, const Point &newPos){
+    if(samePoint(oldPos, newPos)) return;
+    if(points.size() <= 3 || hull.size() < 3){
+        hull = convexHull(points);
+        return;
+    }
+
+    const size_t h = hull.size();
+    size_t k = 0;
+    while(k < h && !samePoint(hull[k], oldPos)) ++k;
+
+    if(k < h){
+        const Point prev = hull[(k+h-1)%h];
+        const Point next = hull[(k+1)%h];
+        const Point &old = hull[k];
+        if(turn(prev, newPos, old) >= 0 && turn(newPos, next, old) >= 0){
+            // Вершина ушла наружу: старый треугольник (prev, old, next) лежит в
+            // новом (prev, newPos, next), карман остается закрытым
+            hull.erase(hull.begin() + k);
+        } else {
+            // Вершина ушла внутрь: вместо нее - оболочка точек кармана за хордой prev -> next.
+            // Сама перенесенная точка (и ее копии) добавляется ниже общей вставкой
+            vector<Point> pocket{prev, next};
+            for(const Point &q: points)
+                if(!samePoint(q, newPos) && turn(prev, next, q) < 0) pocket.push_back(q);
+
+            vector<Point> chain;
+            if(pocket.size() == 3){
+                chain.push_back(pocket[2]);
+            } else if(pocket.size() > 3){
+                vector<Point> sub = convexHull(pocket, false);
+                auto from = find_if(sub.begin(), sub.end(), [&](const Point &q){ return samePoint(q, prev); });
+                if(from != sub.end()) rotate(sub.begin(), from, sub.end());
+                size_t i = 1;
+                while(i < sub.size() && !samePoint(sub[i], next)) chain.push_back(sub[i++]);
+                if(from == sub.end() || i == sub.size()){
+                    // prev или next потерялись из-за округления
+                    hull = convexHull(points);
+                    return;
+                }
+            }
+            hull.erase(hull.begin() + k);
+            hull.insert(hull.begin() + k, chain.begin(), chain.end());
+        }
+    }
+    if(hull.size() < 3 || !insertHullPoint(hull, newPos)){
+        hull = convexHull(points);
+        return;
+    }
+    startAtLowest(hull);
+}
+
 // Минимальное расстояние между точками полигона
 double Geometry::minDistance(const vector<Point> &polygon){
     double minDist = numeric_limits<double>::max();
@@ -0,0 +1,83 @@
+// updateConvexHull против convexHull с нуля: случайные переносы одной точки -
+// наружу, внутрь, вдоль оболочки, на место другой точки. Решетка с целыми
+// координатами дает коллинеарные точки и совпадения
+#include "PlaneGeometry/Geometry.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+int failures = 0;
+
+bool sameHull(const vector<Point> &a, const vector<Point> &b){
+    if(a.size() != b.size()) return false;
+    for(size_t i=0;i<a.size();++i)
+        if(a[i].x != b[i].x || a[i].y != b[i].y) return false;
+    return true;
+}
+
+// moves переносов одной точки из n; coord дает новое положение
+template <class Coord>
+void run(const char *kind, int seed, int n, int moves, Coord coord){
+    mt19937 rng(seed);
+    vector<Point> points;
+    for(int i=0;i<n;++i) points.push_back(coord(rng));
+    vector<Point> hull = Geometry::convexHull(points);
+
+    uniform_int_distribution<int> pick(0, n-1), choice(0, 3);
+    for(int m=0;m<moves;++m){
+        int i = pick(rng);
+        // Чаще двигаем вершины оболочки: только у них есть что чинить
+        if(choice(rng) != 0 && !hull.empty()){
+            const Point &v = hull[pick(rng) % hull.size()];
+            for(int j=0;j<n;++j)
+                if(points[j].x == v.x && points[j].y == v.y){ i = j; break; }
+        }
+        Point oldPos = points[i];
+        Point newPos = choice(rng) == 0 ? points[pick(rng)] : coord(rng);
+        points[i] = newPos;
+
+        Geometry::updateConvexHull(hull, points, oldPos, newPos);
+        vector<Point> expected = Geometry::convexHull(points);
+        if(!sameHull(hull, expected)){
+            printf("%s seed %d, move %d: %zu hull vertices, expected %zu\n",
+                   kind, seed, m, hull.size(), expected.size());
+            ++failures;
+            hull = expected;
+        }
+    }
+}
+
+}
+
+int main(){
+    for(int seed=0;seed<200;++seed){
+        uniform_real_distribution<double> u(0, 100);
+        run("random", seed, 3 + seed % 40, 200, [&](mt19937 &rng){ return Point(u(rng), u(rng)); });
+    }
+    for(int seed=0;seed<200;++seed){
+        uniform_int_distribution<int> g(0, 5);
+        run("grid", seed, 3 + seed % 30, 200,
+            [&](mt19937 &rng){ return Point(g(rng), g(rng)); });
+    }
+    for(int seed=0;seed<50;++seed){
+        // Точки на окружности - все вершины оболочки, и внутри нее: перенос
+        // вершины внутрь открывает карман с точками
+        uniform_real_distribution<double> angle(0, 2*M_PI), radius(0, 40);
+        run("circle", seed, 100, 200, [&](mt19937 &rng){
+            double t = angle(rng), r = rng() % 2 ? 40 : radius(rng);
+            return Point(50 + r*cos(t), 50 + r*sin(t));
+        });
+    }
+
+    if(failures){
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
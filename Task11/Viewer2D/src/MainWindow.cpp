@@ -12,31 +12,6 @@
 using namespace std;
 
 // Геометрические функции (перенесены сюда)
-vector<Point> MainWindow::convexHull(vector<Point> points) {
-    if(points.size() <= 3) return points;
-    sort(points.begin(), points.end(), [](const Point &a, const Point &b){
-        return a.x < b.x || (a.x == b.x && a.y < b.y);
-    });
-
-    vector<Point> hull;
-    // Нижняя
-    for(auto &p: points) {
-        while(hull.size() >= 2 && ((hull.back()-hull[hull.size()-2]).cross(p-hull.back())) <= 0)
-            hull.pop_back();
-        hull.push_back(p);
-    }
-    // Верхняя
-    size_t t = hull.size() + 1;
-    for(int i = points.size()-2; i>=0; --i){
-        auto &p = points[i];
-        while(hull.size() >= t && ((hull.back()-hull[hull.size()-2]).cross(p-hull.back())) <=0)
-            hull.pop_back();
-        hull.push_back(p);
-    }
-    hull.pop_back();
-    return hull;
-}
-
 double MainWindow::minDistance(const vector<Point> &polygon){
     double minDist = numeric_limits<double>::max();
     for(size_t i=0;i<polygon.size();++i){
@@ -160,15 +135,15 @@ void MainWindow::clearAll(){
 }
 
 void MainWindow::rebuildHull(){
-    std::vector<Point> pts(polygonPoints.begin(), polygonPoints.end());
-    std::vector<Point> h = convexHull(pts);
-    hull.clear();
-    for(const auto &p: h) hull.append(p);
+    hull = Geometry::convexHull(polygonPoints);
+}
+
+void MainWindow::updateHull(const Point &oldPos){
+    Geometry::updateConvexHull(hull, polygonPoints, oldPos, polygonPoints[draggedIndex]);
 }
 
 void MainWindow::rebuildDelta(){
-    std::vector<Point> h(hull.begin(), hull.end());
-    delta = minDistance(h)/10.0;
+    delta = minDistance(hull)/10.0;
 }
 
 QColor MainWindow::getColorForPosition(PointPosition position){
@@ -212,13 +187,13 @@ void MainWindow::paintEvent(QPaintEvent *){
 
         // Текст с количеством вершин
         painter.setPen(Qt::darkGreen);
-        painter.drawText(20, 40, QString("Вершин оболочки: %1").arg(hull.size()));
+        painter.drawText(20, 40, QString("Вершин оболочки: %1").arg((int)hull.size()));
     }
 
     // Рисуем исходный полигон (тонкие линии)
     if(polygonPoints.size()>=2 && !hullBuilt){
         painter.setPen(QPen(Qt::gray, 1, Qt::DashLine));
-        for(int i=0;i<polygonPoints.size()-1;++i){
+        for(int i=0;i<(int)polygonPoints.size()-1;++i){
             painter.drawLine(polygonPoints[i].x, polygonPoints[i].y,
                              polygonPoints[i+1].x, polygonPoints[i+1].y);
         }
@@ -227,25 +202,25 @@ void MainWindow::paintEvent(QPaintEvent *){
     // Рисуем точки полигона (синие с номером)
     painter.setPen(Qt::black);
     painter.setBrush(Qt::blue);
-    for(int i=0;i<polygonPoints.size();++i){
+    for(int i=0;i<(int)polygonPoints.size();++i){
         const auto &p = polygonPoints[i];
         painter.drawEllipse(QPointF(p.x, p.y), 6, 6);
         painter.drawText(p.x + 10, p.y - 10, QString::number(i+1));
     }
 
     // Рисуем тестовые точки с цветом по положению и подписью
-    for(int i=0;i<extraPoints.size();++i){
+    for(int i=0;i<(int)extraPoints.size();++i){
         const auto &p = extraPoints[i];
         QColor pointColor = Qt::red;
         QString positionText = "P";
 
         if(hullBuilt){
-            PointPosition pos = pointInPolygon(p, std::vector<Point>(hull.begin(), hull.end()), delta);
+            PointPosition pos = pointInPolygon(p, hull, delta);
             pointColor = getColorForPosition(pos);
             positionText = getStatusText(pos);
 
             // Отображаем статус для последней точки
-            if(i == extraPoints.size()-1){
+            if(i == (int)extraPoints.size()-1){
                 painter.setPen(Qt::black);
                 painter.drawText(p.x + 15, p.y - 15, positionText);
             }
@@ -289,7 +264,7 @@ void MainWindow::mousePressEvent(QMouseEvent *event){
     draggingPolygonPoint = false;
 
     // Проверяем нажатие на точки полигона
-    for(int i=0;i<polygonPoints.size();++i){
+    for(int i=0;i<(int)polygonPoints.size();++i){
         double d2 = (polygonPoints[i].x - pos.x())*(polygonPoints[i].x - pos.x()) +
                     (polygonPoints[i].y - pos.y())*(polygonPoints[i].y - pos.y());
         if(d2 < 64.0){ // радиус 8 пикселей
@@ -301,7 +276,7 @@ void MainWindow::mousePressEvent(QMouseEvent *event){
     }
 
     // Проверяем нажатие на тестовые точки
-    for(int i=0;i<extraPoints.size();++i){
+    for(int i=0;i<(int)extraPoints.size();++i){
         double d2 = (extraPoints[i].x - pos.x())*(extraPoints[i].x - pos.x()) +
                     (extraPoints[i].y - pos.y())*(extraPoints[i].y - pos.y());
         if(d2 < 64.0){
@@ -322,20 +297,19 @@ void MainWindow::mousePressEvent(QMouseEvent *event){
 
         if(!exists){
             if(!hullBuilt){
-                polygonPoints.append(Point(pos.x(), pos.y()));
+                polygonPoints.push_back(Point(pos.x(), pos.y()));
                 statusLabel->setText(QString("Точка %1 добавлена. Всего точек: %2. Добавьте ещё или постройте оболочку.")
-                                         .arg(polygonPoints.size())
-                                         .arg(polygonPoints.size()));
-                statusBar()->showMessage(QString("Добавлена точка #%1").arg(polygonPoints.size()));
+                                         .arg((int)polygonPoints.size())
+                                         .arg((int)polygonPoints.size()));
+                statusBar()->showMessage(QString("Добавлена точка #%1").arg((int)polygonPoints.size()));
             } else {
-                extraPoints.append(Point(pos.x(), pos.y()));
-                statusBar()->showMessage(QString("Добавлена тестовая точка P%1").arg(extraPoints.size()));
+                extraPoints.push_back(Point(pos.x(), pos.y()));
+                statusBar()->showMessage(QString("Добавлена тестовая точка P%1").arg((int)extraPoints.size()));
 
                 // Обновляем статус
-                if(!extraPoints.isEmpty()){
-                    PointPosition posEnum = pointInPolygon(extraPoints.last(),
-                                                           std::vector<Point>(hull.begin(), hull.end()),
-                                                           delta);
+                if(!extraPoints.empty()){
+                    PointPosition posEnum = pointInPolygon(extraPoints.back(),
+                                                           hull, delta);
                     statusLabel->setText(getStatusText(posEnum));
                     QString colorStyle;
                     switch(posEnum){
@@ -357,24 +331,23 @@ void MainWindow::mouseMoveEvent(QMouseEvent *event){
 
     QPointF pos = event->localPos();
     if(draggingPolygonPoint){
+        const Point oldPos = polygonPoints[draggedIndex];
         polygonPoints[draggedIndex] = Point(pos.x(), pos.y());
         if(hullBuilt){
-            rebuildHull();
+            updateHull(oldPos);
             rebuildDelta();
             // Обновляем статус тестовых точек
-            if(!extraPoints.isEmpty()){
-                PointPosition posEnum = pointInPolygon(extraPoints.last(),
-                                                       std::vector<Point>(hull.begin(), hull.end()),
-                                                       delta);
+            if(!extraPoints.empty()){
+                PointPosition posEnum = pointInPolygon(extraPoints.back(),
+                                                       hull, delta);
                 statusLabel->setText(getStatusText(posEnum));
             }
         }
     } else {
         extraPoints[draggedIndex] = Point(pos.x(), pos.y());
-        if(hullBuilt && !extraPoints.isEmpty()){
+        if(hullBuilt && !extraPoints.empty()){
             PointPosition posEnum = pointInPolygon(extraPoints[draggedIndex],
-                                                   std::vector<Point>(hull.begin(), hull.end()),
-                                                   delta);
+                                                   hull, delta);
             statusLabel->setText(getStatusText(posEnum));
         }
     }
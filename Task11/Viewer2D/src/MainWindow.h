@@ -1,6 +1,5 @@
 #pragma once
 #include <QMainWindow>
-#include <QVector>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QLabel>
@@ -8,34 +7,8 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <cmath>
-
-struct Point {
-    double x, y;
-
-    Point() : x(0), y(0) {}
-    Point(double x, double y) : x(x), y(y) {}
-
-    Point operator-(const Point& other) const {
-        return Point(x - other.x, y - other.y);
-    }
-
-    double dist2(const Point& other) const {
-        double dx = x - other.x;
-        double dy = y - other.y;
-        return dx*dx + dy*dy;
-    }
-
-    double cross(const Point& other) const {
-        return x * other.y - y * other.x;
-    }
-};
-
-enum class PointPosition {
-    Inside,
-    Outside,
-    OnBoundary,
-    NearBoundary
-};
+#include <vector>
+#include "PlaneGeometry/Geometry.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -54,19 +27,22 @@ private slots:
     void clearAll();
 
 private:
-    // Геометрические функции (теперь здесь)
-    std::vector<Point> convexHull(std::vector<Point> points);
+    // Геометрические функции (теперь здесь); оболочка строится в PlaneGeometry
     double minDistance(const std::vector<Point>& polygon);
     PointPosition pointInPolygon(const Point &p, const std::vector<Point> &polygon, double delta);
 
     void rebuildDelta();
     void rebuildHull();
+    // Починка оболочки после переноса одной точки полигона из oldPos
+    void updateHull(const Point &oldPos);
     QColor getColorForPosition(PointPosition position);
     QString getStatusText(PointPosition position);
 
-    QVector<Point> polygonPoints;     // исходные точки полигона
-    QVector<Point> hull;              // вершины выпуклой оболочки
-    QVector<Point> extraPoints;       // тестовые точки
+    // std::vector, а не QVector: геометрия принимает их без копирования,
+    // и перенос точки не перекладывает все точки и оболочку
+    std::vector<Point> polygonPoints;     // исходные точки полигона
+    std::vector<Point> hull;              // вершины выпуклой оболочки
+    std::vector<Point> extraPoints;       // тестовые точки
     bool hullBuilt;
     double delta;
     int draggedIndex;
@@ -7,12 +7,22 @@ struct Point {
     Point(double xx=0,double yy=0) : x(xx), y(yy) {}
 };
 
-enum class PointPosition { Inside, Outside, NearBoundary };
+enum class PointPosition { Inside, Outside, OnBoundary, NearBoundary };
 
 namespace Geometry {
 
-// convexHull алгоритм Andrew’s monotone chain
-std::vector<Point> convexHull(std::vector<Point> points);
+// convexHull алгоритм Andrew’s monotone chain; cullInterior - отсечь внутренние
+// точки перед сортировкой (на результат не влияет), в culled - сколько отсечено
+std::vector<Point> convexHull(std::vector<Point> points, bool cullInterior = true, size_t *culled = nullptr);
+
+// То же без выделения памяти: points[0..n) - рабочий буфер (содержимое портится),
+// hull - место минимум под n + 1 точку. Возвращает число вершин в hull
+size_t convexHull(Point *points, size_t n, Point *hull, bool cullInterior = true, size_t *culled = nullptr);
+
+// Удаляет точки внутри восьмиугольника Акла-Туссена, возвращает их число
+size_t cullInteriorPoints(std::vector<Point> &points);
+// То же на месте: оставшиеся точки сдвигаются в начало points[0..n)
+size_t cullInteriorPoints(Point *points, size_t n);
 
 // Проверка положения точки относительно полигона с дырками
 PointPosition pointInPolygon(const Point &p, const std::vector<std::vector<Point>> &polygons, double delta);
@@ -1,60 +1,139 @@
+#include "PlaneGeometry/Geometry.h"
+#include "PlaneGeometry/Predicates.h"
+#include "PlaneGeometry/RadixSort.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
-struct Point {
-    double x, y;
-
-    Point() : x(0), y(0) {}
-    Point(double x, double y) : x(x), y(y) {}
-};
+// ------------------ отсечение Акла-Туссена ------------------
+// Точки строго внутри восьмиугольника из крайних точек по x, y, x+y и x-y
+// не могут быть вершинами оболочки и удаляются до сортировки
+namespace {
+const size_t CullMinPoints = 64;     // на меньших наборах проход не окупается
+const size_t CullBlock = 1024;
+// Оценка погрешности векторного произведения в double (по Шевчуку) с запасом
+const double CullEpsilon = std::numeric_limits<double>::epsilon() / 2;
+const double CullErrBound = 2 * (3.0 + 16.0 * CullEpsilon) * CullEpsilon;
+
+bool samePoint(const Point &a, const Point &b){ return a.x == b.x && a.y == b.y; }
+}
 
-enum class PointPosition {
-    Inside,
-    Outside,
-    OnBoundary,
-    NearBoundary
-};
+size_t Geometry::cullInteriorPoints(Point *points, size_t n){
+    if(n < CullMinPoints) return 0;
+
+    // Крайние точки против часовой начиная с самой левой:
+    // min x, min x+y, min y, max x-y, max x, max x+y, max y, min x-y
+    size_t ext[8] = {};
+    for(size_t i = 1; i < n; ++i){
+        const Point &p = points[i];
+        if(p.x < points[ext[0]].x) ext[0] = i;
+        if(p.x + p.y < points[ext[1]].x + points[ext[1]].y) ext[1] = i;
+        if(p.y < points[ext[2]].y) ext[2] = i;
+        if(p.x - p.y > points[ext[3]].x - points[ext[3]].y) ext[3] = i;
+        if(p.x > points[ext[4]].x) ext[4] = i;
+        if(p.x + p.y > points[ext[5]].x + points[ext[5]].y) ext[5] = i;
+        if(p.y > points[ext[6]].y) ext[6] = i;
+        if(p.x - p.y < points[ext[7]].x - points[ext[7]].y) ext[7] = i;
+    }
 
-// Убираем namespace Geometry и делаем функции глобальными
+    Point octagon[8];
+    size_t m = 0;
+    for(size_t k = 0; k < 8; ++k)
+        if(m == 0 || !samePoint(points[ext[k]], octagon[m-1])) octagon[m++] = points[ext[k]];
+    while(m > 1 && samePoint(octagon[m-1], octagon[0])) --m;
+    if(m < 3) return 0;
+
+    // Недостающие до восьми ребра повторяют последнее - внутренний цикл разворачивается
+    double ax[8], ay[8], dx[8], dy[8];
+    for(size_t k = 0; k < 8; ++k){
+        size_t j = std::min(k, m-1);
+        ax[k] = octagon[j].x;
+        ay[k] = octagon[j].y;
+        dx[k] = octagon[(j+1) % m].x - octagon[j].x;
+        dy[k] = octagon[(j+1) % m].y - octagon[j].y;
+    }
 
-// ------------------ convexHull ------------------
-std::vector<Point> convexHull(std::vector<Point> points) {
-    if(points.size() <= 1) return points;
+    // Запас над оценкой погрешности по всем ребрам без ветвлений (векторизуется),
+    // затем оставшиеся точки уплотняются на месте
+    double margin[CullBlock];
+    size_t kept = 0;
+    for(size_t begin = 0; begin < n; begin += CullBlock){
+        const size_t count = std::min(CullBlock, n - begin);
+        const Point *block = points + begin;
+        for(size_t i = 0; i < count; ++i){
+            double least = std::numeric_limits<double>::infinity();
+            for(size_t k = 0; k < 8; ++k){
+                double t1 = dx[k] * (block[i].y - ay[k]);
+                double t2 = dy[k] * (block[i].x - ax[k]);
+                least = std::min(least, t1 - t2 - CullErrBound * (std::fabs(t1) + std::fabs(t2)));
+            }
+            margin[i] = least;
+        }
+        for(size_t i = 0; i < count; ++i){
+            points[kept] = block[i];
+            kept += !(margin[i] > 0);
+        }
+    }
+    return n - kept;
+}
 
-    std::sort(points.begin(), points.end(), [](const Point &a, const Point &b){
-        return a.x < b.x || (a.x == b.x && a.y < b.y);
-    });
+size_t Geometry::cullInteriorPoints(std::vector<Point> &points){
+    size_t removed = cullInteriorPoints(points.data(), points.size());
+    points.resize(points.size() - removed);
+    return removed;
+}
 
-    std::vector<Point> lower, upper;
+// ------------------ convexHull ------------------
+size_t Geometry::convexHull(Point *points, size_t n, Point *hull, bool cullInterior, size_t *culled) {
+    if(culled) *culled = 0;
+    if(n <= 1){
+        std::copy(points, points + n, hull);
+        return n;
+    }
+    if(cullInterior){
+        size_t removed = cullInteriorPoints(points, n);
+        n -= removed;
+        if(culled) *culled = removed;
+    }
 
-    for(const auto &p : points){
-        while(lower.size() >= 2){
-            Point q = lower[lower.size()-2];
-            Point r = lower[lower.size()-1];
-            if((r.x - q.x)*(p.y - q.y) - (r.y - q.y)*(p.x - q.x) <= 0)
-                lower.pop_back();
+    // Выходной буфер до построения оболочки служит рабочим для сортировки
+    radixSortByPoint(points, n, hull, [](const Point &p) -> const Point & { return p; });
+
+    // Нижняя цепочка, затем верхняя поверх нее; последняя точка каждой
+    // совпадает с первой точкой следующей и отбрасывается
+    size_t k = 0;
+    for(size_t i = 0; i < n; ++i){
+        const Point &p = points[i];
+        while(k >= 2){
+            const Point &q = hull[k-2];
+            const Point &r = hull[k-1];
+            if(orient2d(q, r, p) <= 0)
+                --k;
             else break;
         }
-        lower.push_back(p);
+        hull[k++] = p;
     }
 
-    for(auto it = points.rbegin(); it != points.rend(); ++it){
-        const Point &p = *it;
-        while(upper.size() >= 2){
-            Point q = upper[upper.size()-2];
-            Point r = upper[upper.size()-1];
-            if((r.x - q.x)*(p.y - q.y) - (r.y - q.y)*(p.x - q.x) <= 0)
-                upper.pop_back();
+    const size_t lower = k + 1;
+    for(size_t i = n - 1; i-- > 0; ){
+        const Point &p = points[i];
+        while(k >= lower){
+            const Point &q = hull[k-2];
+            const Point &r = hull[k-1];
+            if(orient2d(q, r, p) <= 0)
+                --k;
             else break;
         }
-        upper.push_back(p);
+        hull[k++] = p;
     }
+    return k - 1;
+}
 
-    lower.pop_back();
-    upper.pop_back();
-    lower.insert(lower.end(), upper.begin(), upper.end());
-    return lower;
+std::vector<Point> Geometry::convexHull(std::vector<Point> points, bool cullInterior, size_t *culled) {
+    std::vector<Point> hull(points.size() + 1);
+    hull.resize(convexHull(points.data(), points.size(), hull.data(), cullInterior, culled));
+    return hull;
 }
 
 // ------------------ distancePointToSegment ------------------
@@ -98,7 +177,7 @@ inline bool onBoundary(const Point &p, const std::vector<Point> &poly, double de
 }
 
 // ------------------ pointInPolygon для полигона с дырками ------------------
-PointPosition pointInPolygon(const Point &p, const std::vector<std::vector<Point>> &polygons, double delta){
+PointPosition Geometry::pointInPolygon(const Point &p, const std::vector<std::vector<Point>> &polygons, double delta){
     if(polygons.empty()) return PointPosition::Outside;
 
     // проверка границы всех контуров
@@ -119,7 +198,7 @@ PointPosition pointInPolygon(const Point &p, const std::vector<std::vector<Point
 }
 
 // ------------------ minDistance ------------------
-double minDistance(const std::vector<Point> &points){
+double Geometry::minDistance(const std::vector<Point> &points){
     double minD = 1e9;
     int n = points.size();
     for(int i=0;i<n;i++){
@@ -0,0 +1,108 @@
+#include "PlaneGeometry/Predicates.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Geometry {
+
+namespace {
+
+// Точная арифметика разложений: число хранится как сумма неперекрывающихся
+// компонент по возрастанию модуля, знак суммы равен знаку старшей компоненты
+using Expansion = std::vector<double>;
+
+constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;   // 2^-53
+constexpr double CcwErrBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+
+void twoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void twoProduct(double a, double b, double& x, double& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// e + b с удалением нулевых компонент
+Expansion grow(const Expansion& e, double b) {
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double component : e) {
+        double sum, err;
+        twoSum(q, component, sum, err);
+        if (err != 0) h.push_back(err);
+        q = sum;
+    }
+    if (q != 0 || h.empty()) h.push_back(q);
+    return h;
+}
+
+Expansion add(Expansion e, const Expansion& f) {
+    for (double component : f) e = grow(e, component);
+    return e;
+}
+
+Expansion negate(Expansion e) {
+    for (double& component : e) component = -component;
+    return e;
+}
+
+Expansion multiply(const Expansion& e, const Expansion& f) {
+    Expansion result{0.0};
+    for (double a : e) {
+        for (double b : f) {
+            double x, y;
+            twoProduct(a, b, x, y);
+            result = grow(result, y);
+            result = grow(result, x);
+        }
+    }
+    return result;
+}
+
+Expansion difference(double a, double b) {
+    double x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    double y = (a - av) + (bv - b);
+    return grow(Expansion{y}, x);
+}
+
+double estimate(const Expansion& e) {
+    return e.back();
+}
+
+double orient2dExact(const Point& a, const Point& b, const Point& c) {
+    Expansion acx = difference(a.x, c.x), acy = difference(a.y, c.y);
+    Expansion bcx = difference(b.x, c.x), bcy = difference(b.y, c.y);
+    return estimate(add(multiply(acx, bcy), negate(multiply(acy, bcx))));
+}
+
+} // namespace
+
+double orient2d(const Point& a, const Point& b, const Point& c) {
+    double detleft  = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright;
+
+    double detsum;
+    if (detleft > 0) {
+        if (detright <= 0) return det;
+        detsum = detleft + detright;
+    } else if (detleft < 0) {
+        if (detright >= 0) return det;
+        detsum = -detleft - detright;
+    } else {
+        return det;
+    }
+
+    double errbound = CcwErrBound * detsum;
+    if (det >= errbound || -det >= errbound) return det;
+    return orient2dExact(a, b, c);
+}
+
+}
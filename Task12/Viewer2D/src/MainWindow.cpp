@@ -135,7 +135,7 @@ void MainWindow::buildConvexHull() {
 
     // Строим выпуклую оболочку
     convexHullPoints.clear();
-    auto hull = convexHull(allPoints);
+    auto hull = Geometry::convexHull(allPoints);
     for (const auto& p : hull) {
         convexHullPoints.append(p);
     }
@@ -156,7 +156,7 @@ void MainWindow::rebuildDelta() {
         }
     }
 
-    delta = minDistance(allPoints) / 10.0;
+    delta = Geometry::minDistance(allPoints) / 10.0;
 }
 
 void MainWindow::paintEvent(QPaintEvent *) {
@@ -238,7 +238,7 @@ void MainWindow::paintEvent(QPaintEvent *) {
                 stdPolygons.push_back(vector<Point>(poly.begin(), poly.end()));
             }
 
-            PointPosition pos = pointInPolygon(p, stdPolygons, delta);
+            PointPosition pos = Geometry::pointInPolygon(p, stdPolygons, delta);
             color = getColorForPosition(pos);
             status = getStatusText(pos);
 
@@ -398,7 +398,7 @@ void MainWindow::updateTestPointStatus() {
     }
 
     const Point& lastPoint = testPoints.last();
-    PointPosition pos = pointInPolygon(lastPoint, stdPolygons, delta);
+    PointPosition pos = Geometry::pointInPolygon(lastPoint, stdPolygons, delta);
 
     QString status = QString("Тестовая точка P%1: %2")
                          .arg(testPoints.size())
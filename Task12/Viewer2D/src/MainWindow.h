@@ -10,20 +10,7 @@
 #include <QHBoxLayout>
 #include <QStatusBar>
 #include <vector>
-
-struct Point {
-    double x, y;
-
-    Point() : x(0), y(0) {}
-    Point(double x, double y) : x(x), y(y) {}
-};
-
-enum class PointPosition {
-    Inside,
-    Outside,
-    OnBoundary,
-    NearBoundary
-};
+#include "PlaneGeometry/Geometry.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -67,9 +54,4 @@ private:
     void updateTestPointStatus();
 };
 
-// Объявляем геометрические функции (вне класса!)
-std::vector<Point> convexHull(std::vector<Point> points);
-double minDistance(const std::vector<Point>& points);
-PointPosition pointInPolygon(const Point& p, const std::vector<std::vector<Point>>& polygons, double delta);
-
 #endif // MAINWINDOW_H
@@ -1,49 +1,186 @@
 #include "convex_hull.hpp"
+#include "predicates.hpp"
+#include "radix_sort.hpp"
+#include "work_stealing.hpp"
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
-std::vector<Point> ConvexHull::compute(const std::vector<Point>& points) {
-    int n = points.size();
-    if (n < 3) {
-        return points;
+namespace Task5 {
+
+namespace {
+
+// На меньших наборах проход отсечения не окупается
+const std::size_t CullMinPoints = 64;
+const std::size_t CullBlock = 1024;
+// Наборов в одной порции пакетного построения
+const std::size_t BatchGrain = 64;
+// Оценка погрешности векторного произведения в double (по Шевчуку) с запасом: при большем
+// значении точка гарантированно слева от ребра
+const double CullEpsilon = std::numeric_limits<double>::epsilon() / 2;
+const double CullErrBound = 2 * (3.0 + 16.0 * CullEpsilon) * CullEpsilon;
+
+bool samePoint(const Point& a, const Point& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+}
+
+std::size_t ConvexHull::cullInteriorPoints(Point* points, std::size_t n) {
+    if (n < CullMinPoints) {
+        return 0;
     }
 
-    std::vector<Point> sorted_points = points;
-    std::sort(sorted_points.begin(), sorted_points.end());
-
-    std::vector<Point> lower;
-    for (int i = 0; i < n; ++i) {
-        while (lower.size() >= 2) {
-            Point& a = lower[lower.size() - 2];
-            Point& b = lower[lower.size() - 1];
-            if (cross(a, b, sorted_points[i]) <= 0) {
-                lower.pop_back();
-            } else {
-                break;
-            }
+    // Крайние точки против часовой стрелки начиная с самой левой:
+    // min x, min x+y, min y, max x-y, max x, max x+y, max y, min x-y
+    std::size_t ext[8] = {};
+    for (std::size_t i = 1; i < n; ++i) {
+        const Point& p = points[i];
+        if (p.x < points[ext[0]].x) ext[0] = i;
+        if (p.x + p.y < points[ext[1]].x + points[ext[1]].y) ext[1] = i;
+        if (p.y < points[ext[2]].y) ext[2] = i;
+        if (p.x - p.y > points[ext[3]].x - points[ext[3]].y) ext[3] = i;
+        if (p.x > points[ext[4]].x) ext[4] = i;
+        if (p.x + p.y > points[ext[5]].x + points[ext[5]].y) ext[5] = i;
+        if (p.y > points[ext[6]].y) ext[6] = i;
+        if (p.x - p.y < points[ext[7]].x - points[ext[7]].y) ext[7] = i;
+    }
+
+    Point octagon[8];
+    std::size_t m = 0;
+    for (std::size_t k = 0; k < 8; ++k) {
+        if (m == 0 || !samePoint(points[ext[k]], octagon[m - 1])) {
+            octagon[m++] = points[ext[k]];
         }
-        lower.push_back(sorted_points[i]);
-    }
-
-    std::vector<Point> upper;
-    for (int i = n - 1; i >= 0; --i) {
-        while (upper.size() >= 2) {
-            Point& a = upper[upper.size() - 2];
-            Point& b = upper[upper.size() - 1];
-            if (cross(a, b, sorted_points[i]) <= 0) {
-                upper.pop_back();
-            } else {
-                break;
+    }
+    while (m > 1 && samePoint(octagon[m - 1], octagon[0])) {
+        --m;
+    }
+    if (m < 3) {
+        return 0;
+    }
+
+    // Недостающие до восьми ребра повторяют последнее, чтобы внутренний
+    // цикл имел постоянную длину и разворачивался
+    double ax[8], ay[8], dx[8], dy[8];
+    for (std::size_t k = 0; k < 8; ++k) {
+        std::size_t j = std::min(k, m - 1);
+        ax[k] = octagon[j].x;
+        ay[k] = octagon[j].y;
+        dx[k] = octagon[(j + 1) % m].x - octagon[j].x;
+        dy[k] = octagon[(j + 1) % m].y - octagon[j].y;
+    }
+
+    // Наименьший по ребрам запас над оценкой погрешности считается без
+    // ветвлений (цикл векторизуется), затем оставшиеся точки уплотняются
+    double margin[CullBlock];
+    std::size_t kept = 0;
+    for (std::size_t begin = 0; begin < n; begin += CullBlock) {
+        const std::size_t count = std::min(CullBlock, n - begin);
+        const Point* block = points + begin;
+        for (std::size_t i = 0; i < count; ++i) {
+            double least = std::numeric_limits<double>::infinity();
+            for (std::size_t k = 0; k < 8; ++k) {
+                double t1 = dx[k] * (block[i].y - ay[k]);
+                double t2 = dy[k] * (block[i].x - ax[k]);
+                least = std::min(least, t1 - t2 - CullErrBound * (std::fabs(t1) + std::fabs(t2)));
             }
+            margin[i] = least;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            points[kept] = block[i];
+            kept += !(margin[i] > 0);
         }
-        upper.push_back(sorted_points[i]);
     }
+    return n - kept;
+}
 
-    lower.pop_back();
-    upper.pop_back();
+std::size_t ConvexHull::cullInteriorPoints(std::vector<Point>& points) {
+    std::size_t removed = cullInteriorPoints(points.data(), points.size());
+    points.resize(points.size() - removed);
+    return removed;
+}
 
-    std::vector<Point> hull = lower;
-    hull.insert(hull.end(), upper.begin(), upper.end());
+std::size_t ConvexHull::compute(Point* points, std::size_t n, Point* hull, bool cullInterior, Stats* stats) {
+    if (stats) {
+        stats->input = n;
+        stats->culled = 0;
+    }
+    if (n < 3) {
+        std::copy(points, points + n, hull);
+        return n;
+    }
+
+    if (cullInterior) {
+        std::size_t culled = cullInteriorPoints(points, n);
+        n -= culled;
+        if (stats) stats->culled = culled;
+    }
+    // Выходной буфер до построения оболочки служит рабочим для сортировки
+    radixSortByPoint(points, n, hull, [](const Point& p) -> const Point& { return p; });
+
+    // Нижняя цепочка, затем верхняя прямо за ней; последняя точка каждой
+    // цепочки совпадает с первой точкой следующей
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        while (k >= 2 && orient2d(hull[k - 2], hull[k - 1], points[i]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+
+    const std::size_t lower = k + 1;
+    for (std::size_t i = n - 1; i-- > 0; ) {
+        while (k >= lower && orient2d(hull[k - 2], hull[k - 1], points[i]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+
+    return k - 1;
+}
 
+std::vector<Point> ConvexHull::compute(const std::vector<Point>& points, bool cullInterior, Stats* stats) {
+    std::vector<Point> sorted_points = points;
+    std::vector<Point> hull(points.size() + 1);
+    hull.resize(compute(sorted_points.data(), sorted_points.size(), hull.data(), cullInterior, stats));
     return hull;
 }
+
+void ConvexHull::computeBatch(const std::vector<Point>& points, const std::vector<std::size_t>& offsets,
+                              std::vector<Point>& hulls, std::vector<std::size_t>& hullOffsets,
+                              unsigned threads) {
+    const std::size_t sets = offsets.empty() ? 0 : offsets.size() - 1;
+    hullOffsets.assign(sets + 1, 0);
+    if (sets == 0) {
+        hulls.clear();
+        return;
+    }
+
+    // Набор i копируется в рабочий буфер порции (он остается в кэше), а
+    // оболочка пишется в слот hulls[offsets[i] - base + i], где есть место
+    // под n + 1 точку; после построения слоты уплотняются
+    const std::size_t base = offsets[0];
+    hulls.resize(offsets[sets] - base + sets);
+
+    parallelFor(sets, threads, BatchGrain, [&](std::size_t begin, std::size_t end) {
+        std::vector<Point> scratch;
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t n = offsets[i + 1] - offsets[i];
+            scratch.assign(points.begin() + offsets[i], points.begin() + offsets[i + 1]);
+            hullOffsets[i + 1] = compute(scratch.data(), n, hulls.data() + offsets[i] - base + i);
+        }
+    });
+
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < sets; ++i) {
+        const Point* slot = hulls.data() + offsets[i] - base + i;
+        std::copy(slot, slot + hullOffsets[i + 1], hulls.data() + size);
+        size += hullOffsets[i + 1];
+        hullOffsets[i + 1] = size;
+    }
+    hulls.resize(size);
+}
+
+}
@@ -3,27 +3,44 @@
 
 #include <vector>
 #include <algorithm>
-#include <QPointF>
+#include "point.hpp"
 
-struct Point {
-    double x, y;
-    Point(double x = 0, double y = 0) : x(x), y(y) {}
-    Point(const QPointF& p) : x(p.x()), y(p.y()) {}
-
-    QPointF toQPointF() const { return QPointF(x, y); }
-
-    bool operator<(const Point& p) const {
-        return x < p.x || (x == p.x && y < p.y);
-    }
-};
+namespace Task5 {
 
 class ConvexHull {
 public:
-    static std::vector<Point> compute(const std::vector<Point>& points);
+    // Счетчики одного построения
+    struct Stats {
+        std::size_t input = 0;    // точек на входе
+        std::size_t culled = 0;   // отброшено отсечением внутренних точек
+    };
+
+    // cullInterior - перед сортировкой отбросить точки внутри восьмиугольника
+    // Акла-Туссена (на результат не влияет)
+    static std::vector<Point> compute(const std::vector<Point>& points,
+                                      bool cullInterior = true, Stats* stats = nullptr);
 
-    static double cross(const Point& a, const Point& b, const Point& c) {
-        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
-    }
+    // То же без выделения памяти: points[0..n) - рабочий буфер (содержимое
+    // портится), hull - место минимум под n + 1 точку. Возвращает число вершин
+    static std::size_t compute(Point* points, std::size_t n, Point* hull,
+                               bool cullInterior = true, Stats* stats = nullptr);
+
+    // Оболочки множества независимых наборов за один вызов. Вход в формате CSR:
+    // набор i - points[offsets[i] .. offsets[i + 1]). Оболочка набора i
+    // записывается в hulls[hullOffsets[i] .. hullOffsets[i + 1]); векторы
+    // результата переиспользуют свою память между вызовами. Наборы
+    // распределяются по потокам с перехватом работы, threads == 0 - по числу ядер
+    static void computeBatch(const std::vector<Point>& points, const std::vector<std::size_t>& offsets,
+                             std::vector<Point>& hulls, std::vector<std::size_t>& hullOffsets,
+                             unsigned threads = 0);
+
+    // Удаляет точки, строго лежащие внутри восьмиугольника из крайних точек
+    // по x, y, x+y и x-y, сохраняя порядок остальных; возвращает число удаленных
+    static std::size_t cullInteriorPoints(std::vector<Point>& points);
+    // То же для points[0..n): оставшиеся точки сдвигаются в начало
+    static std::size_t cullInteriorPoints(Point* points, std::size_t n);
 };
 
+}
+
 #endif
@@ -0,0 +1,329 @@
+#include "dynamic_hull.hpp"
+#include "predicates.hpp"
+#include "radix_sort.hpp"
+#include <algorithm>
+
+namespace Task5 {
+
+void DynamicConvexHull::assign(const std::vector<Point>& points) {
+    clear();
+    if (points.empty()) return;
+
+    // Листья заводятся по порядку, поэтому устойчивая сортировка по точке
+    // дает тот же порядок, что и less()
+    struct Item {
+        Point point;
+        int leaf;
+    };
+    nodes.reserve(2 * points.size());
+    std::vector<Item> items(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        int v = newNode();
+        Node& leaf = nodes[v];
+        leaf.point = points[i];
+        leaf.minLeaf = leaf.maxLeaf = v;
+        items[i] = {points[i], v};
+    }
+    radixSortByPoint(items, [](const Item& item) -> const Point& { return item.point; });
+    std::vector<int> leaves(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i) leaves[i] = items[i].leaf;
+
+    root = buildBalanced(leaves, 0, leaves.size());
+    nodes[root].parent = -1;
+    count = points.size();
+}
+
+int DynamicConvexHull::buildBalanced(const std::vector<int>& leaves, std::size_t begin, std::size_t end) {
+    if (end - begin == 1) return leaves[begin];
+    std::size_t mid = begin + (end - begin) / 2;
+    int left = buildBalanced(leaves, begin, mid);
+    int right = buildBalanced(leaves, mid, end);
+    int v = newNode();
+    nodes[v].left = left;
+    nodes[v].right = right;
+    nodes[left].parent = nodes[right].parent = v;
+    update(v);
+    return v;
+}
+
+int DynamicConvexHull::insert(const Point& p) {
+    int leaf = newNode();
+    nodes[leaf].point = p;
+    attach(leaf);
+    ++count;
+    return leaf;
+}
+
+void DynamicConvexHull::remove(int handle) {
+    detach(handle);
+    freeNodes.push_back(handle);
+    --count;
+}
+
+void DynamicConvexHull::move(int handle, const Point& p) {
+    detach(handle);
+    nodes[handle].point = p;
+    attach(handle);
+}
+
+void DynamicConvexHull::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+    count = 0;
+}
+
+std::vector<Point> DynamicConvexHull::hull() const {
+    std::vector<Point> upper, lower;
+    if (root < 0) return upper;
+    if (count < 3) {
+        // Меньше трех точек возвращаются в лексикографическом порядке (самый
+        // левый лист, затем самый правый), а не в порядке добавления, как у ConvexHull::compute;
+        // совпавшие точки дают одну вершину
+        const Point& first = nodes[nodes[root].minLeaf].point;
+        const Point& last = nodes[nodes[root].maxLeaf].point;
+        upper.push_back(first);
+        if (last.x != first.x || last.y != first.y) upper.push_back(last);
+        return upper;
+    }
+
+    // Верхняя цепочка идет слева направо, нижняя (в повернутой системе) - справа налево
+    collect(root, -1, -1, Upper, upper);
+    collect(root, -1, -1, Lower, lower);
+
+    std::vector<Point> result;
+    result.reserve(upper.size() + lower.size());
+    auto append = [&](const Point& p) {
+        if (result.empty() || result.back().x != p.x || result.back().y != p.y) result.push_back(p);
+    };
+    for (auto it = lower.rbegin(); it != lower.rend(); ++it) append(*it);
+    for (auto it = upper.rbegin(); it != upper.rend(); ++it) append(*it);
+    while (result.size() > 1 && result.back().x == result.front().x && result.back().y == result.front().y)
+        result.pop_back();
+    return result;
+}
+
+int DynamicConvexHull::newNode() {
+    int v;
+    if (!freeNodes.empty()) {
+        v = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[v] = Node();
+    } else {
+        v = (int)nodes.size();
+        nodes.emplace_back();
+    }
+    return v;
+}
+
+bool DynamicConvexHull::less(int a, int b) const {
+    const Point& p = nodes[a].point;
+    const Point& q = nodes[b].point;
+    if (p.x != q.x) return p.x < q.x;
+    if (p.y != q.y) return p.y < q.y;
+    return a < b;
+}
+
+void DynamicConvexHull::attach(int leaf) {
+    Node& node = nodes[leaf];
+    node.left = node.right = -1;
+    node.height = 0;
+    node.minLeaf = node.maxLeaf = leaf;
+
+    if (root < 0) {
+        node.parent = -1;
+        root = leaf;
+        return;
+    }
+
+    int v = root;
+    while (!isLeaf(v)) {
+        v = less(leaf, nodes[nodes[v].right].minLeaf) ? nodes[v].left : nodes[v].right;
+    }
+
+    // Лист v заменяется узлом с двумя листьями
+    int u = newNode();
+    int parent = nodes[v].parent;
+    nodes[u].parent = parent;
+    replaceChild(parent, v, u);
+    bool leafFirst = less(leaf, v);
+    nodes[u].left = leafFirst ? leaf : v;
+    nodes[u].right = leafFirst ? v : leaf;
+    nodes[leaf].parent = nodes[v].parent = u;
+    rebalance(u);
+}
+
+void DynamicConvexHull::detach(int leaf) {
+    int u = nodes[leaf].parent;
+    nodes[leaf].parent = -1;
+    if (u < 0) {
+        root = -1;
+        return;
+    }
+
+    // Родитель листа исчезает, его место занимает брат
+    int sibling = nodes[u].left == leaf ? nodes[u].right : nodes[u].left;
+    int grandparent = nodes[u].parent;
+    nodes[sibling].parent = grandparent;
+    replaceChild(grandparent, u, sibling);
+    freeNodes.push_back(u);
+    if (grandparent >= 0) rebalance(grandparent);
+}
+
+void DynamicConvexHull::replaceChild(int parent, int from, int to) {
+    if (parent < 0) root = to;
+    else if (nodes[parent].left == from) nodes[parent].left = to;
+    else nodes[parent].right = to;
+}
+
+void DynamicConvexHull::update(int v) {
+    Node& node = nodes[v];
+    node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+    node.minLeaf = nodes[node.left].minLeaf;
+    node.maxLeaf = nodes[node.right].maxLeaf;
+    node.bridge[Upper] = findBridge(v, Upper);
+    node.bridge[Lower] = findBridge(v, Lower);
+}
+
+int DynamicConvexHull::rotate(int v, bool toLeft) {
+    int parent = nodes[v].parent;
+    int u;
+    if (toLeft) {
+        u = nodes[v].right;
+        nodes[v].right = nodes[u].left;
+        nodes[nodes[v].right].parent = v;
+        nodes[u].left = v;
+    } else {
+        u = nodes[v].left;
+        nodes[v].left = nodes[u].right;
+        nodes[nodes[v].left].parent = v;
+        nodes[u].right = v;
+    }
+    nodes[v].parent = u;
+    nodes[u].parent = parent;
+    replaceChild(parent, v, u);
+    update(v);
+    update(u);
+    return u;
+}
+
+void DynamicConvexHull::rebalance(int v) {
+    // Мосты зависят только от поддерева, поэтому пересчитываются снизу вверх по пути к корню
+    for (; v >= 0; v = nodes[v].parent) {
+        int left = nodes[v].left, right = nodes[v].right;
+        int balance = nodes[left].height - nodes[right].height;
+        if (balance > 1) {
+            if (nodes[nodes[left].left].height < nodes[nodes[left].right].height) rotate(left, true);
+            v = rotate(v, false);
+        } else if (balance < -1) {
+            if (nodes[nodes[right].right].height < nodes[nodes[right].left].height) rotate(right, false);
+            v = rotate(v, true);
+        } else {
+            update(v);
+        }
+    }
+}
+
+Point DynamicConvexHull::framed(int leaf, Side side) const {
+    const Point& p = nodes[leaf].point;
+    return side == Upper ? p : Point(-p.x, -p.y);
+}
+
+int DynamicConvexHull::child(int v, bool first, Side side) const {
+    return first == (side == Upper) ? nodes[v].left : nodes[v].right;
+}
+
+bool DynamicConvexHull::before(int a, int b, Side side) const {
+    return side == Upper ? less(a, b) : less(b, a);
+}
+
+void DynamicConvexHull::narrow(int& v, int lo, int hi, Side side) const {
+    // Спуск к узлу, мост которого лежит между вершинами lo и hi (-1 - без границы)
+    while (!isLeaf(v)) {
+        const Bridge& b = nodes[v].bridge[side];
+        if (hi >= 0 && !before(b.first, hi, side)) v = child(v, true, side);
+        else if (lo >= 0 && !before(lo, b.second, side)) v = child(v, false, side);
+        else break;
+    }
+}
+
+DynamicConvexHull::Bridge DynamicConvexHull::findBridge(int v, Side side) const {
+    // Ищется верхний мост (p, q) между оболочками первого (A) и второго (B) поддерева.
+    // Кандидаты на p и q - вершины между границами lo/hi; на каждом шаге ребро
+    // одной из оболочек отсекает половину кандидатов. При совпадениях p берется
+    // левее, q - правее, чтобы на оболочке не оставалось коллинеарных вершин.
+    int a = child(v, true, side), b = child(v, false, side);
+    int loA = -1, hiA = -1, loB = -1, hiB = -1;
+
+    double m = (nodes[nodes[nodes[v].left].maxLeaf].point.x + nodes[nodes[nodes[v].right].minLeaf].point.x) / 2;
+    if (side == Lower) m = -m;
+    const double firstOfB = framed(side == Upper ? nodes[b].minLeaf : nodes[b].maxLeaf, side).x;
+
+    auto moveA = [&](bool toFirst, const Bridge& e) {
+        if (toFirst) hiA = e.first;
+        else loA = e.second;
+        a = child(a, toFirst, side);
+    };
+    auto moveB = [&](bool toFirst, const Bridge& f) {
+        if (toFirst) hiB = f.first;
+        else loB = f.second;
+        b = child(b, toFirst, side);
+    };
+
+    for (;;) {
+        narrow(a, loA, hiA, side);
+        narrow(b, loB, hiB, side);
+        const bool aLeaf = isLeaf(a), bLeaf = isLeaf(b);
+        if (aLeaf && bLeaf) return {a, b};
+
+        const Bridge e = aLeaf ? Bridge{a, a} : nodes[a].bridge[side];
+        const Bridge f = bLeaf ? Bridge{b, b} : nodes[b].bridge[side];
+        const Point a1 = framed(e.first, side), a2 = framed(e.second, side);
+        const Point b1 = framed(f.first, side), b2 = framed(f.second, side);
+
+        // Точка B на прямой ребра A или выше: p не правее a1.
+        // Точка A на прямой ребра B или выше: q не левее b2.
+        if (bLeaf) {
+            moveA(orient2d(a1, a2, b1) >= 0, e);
+        } else if (aLeaf) {
+            moveB(orient2d(b1, b2, a1) < 0, f);
+        } else if (orient2d(a1, a2, b1) >= 0 || orient2d(a1, a2, b2) >= 0) {
+            moveA(true, e);
+        } else if (orient2d(b1, b2, a1) >= 0 || orient2d(b1, b2, a2) >= 0) {
+            moveB(false, f);
+        } else {
+            // Оба ребра под мостом. Прямые ребер пересекаются; если точка пересечения
+            // левее разделяющей вертикали m, p не левее a2, иначе q не правее b1
+            double dxA = a2.x - a1.x, dyA = a2.y - a1.y;
+            double dxB = b2.x - b1.x, dyB = b2.y - b1.y;
+            if (dxA == 0) {
+                // Вертикальное ребро бывает только в начале цепочки A; нижний его конец
+                // остается кандидатом, лишь если в B есть точки на той же вертикали
+                moveA(firstOfB == a1.x, e);
+                continue;
+            }
+            // (e(m) - f(m)) * dxA * dxB, где e и f - прямые ребер
+            double diff = (a1.y - b1.y) * dxA * dxB + (m - a1.x) * dyA * dxB - (m - b1.x) * dyB * dxA;
+            if (diff > 0) moveA(false, e);
+            else moveB(true, f);
+        }
+    }
+}
+
+void DynamicConvexHull::collect(int v, int lo, int hi, Side side, std::vector<Point>& out) const {
+    if (isLeaf(v)) {
+        out.push_back(nodes[v].point);
+        return;
+    }
+    const Bridge& b = nodes[v].bridge[side];
+    if (hi >= 0 && !before(b.first, hi, side)) {
+        collect(child(v, true, side), lo, hi, side, out);
+    } else if (lo >= 0 && !before(lo, b.second, side)) {
+        collect(child(v, false, side), lo, hi, side, out);
+    } else {
+        collect(child(v, true, side), lo, b.first, side, out);
+        collect(child(v, false, side), b.second, hi, side, out);
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+#ifndef DYNAMIC_HULL_HPP
+#define DYNAMIC_HULL_HPP
+
+#include <vector>
+#include "convex_hull.hpp"
+
+namespace Task5 {
+
+// Выпуклая оболочка с добавлением, удалением и перемещением точек за O(log^2 n).
+// Точки лежат в листьях AVL-дерева по возрастанию (x, y); каждый внутренний
+// узел хранит верхний и нижний мосты между оболочками своих поддеревьев
+// (схема Overmars-van Leeuwen без хранения самих цепочек: мост находится
+// одновременным спуском по поддеревьям). Оболочка выдается за O(h log n).
+class DynamicConvexHull {
+public:
+    // Заменяет содержимое набором точек за O(n log n); дескриптор i-й точки равен i
+    void assign(const std::vector<Point>& points);
+
+    // Возвращает дескриптор точки для remove() и move()
+    int insert(const Point& p);
+    void remove(int handle);
+    void move(int handle, const Point& p);
+    void clear();
+
+    std::size_t size() const { return count; }
+    const Point& point(int handle) const { return nodes[handle].point; }
+
+    // Вершины в том же порядке, что и ConvexHull::compute; без повторов, и
+    // вырожденная оболочка (меньше трех вершин) - по возрастанию (x, y)
+    std::vector<Point> hull() const;
+
+private:
+    enum Side { Upper = 0, Lower = 1 };
+
+    struct Bridge {
+        int first = -1;    // лист в первом поддереве (в системе отсчета стороны)
+        int second = -1;   // лист во втором поддереве
+    };
+
+    struct Node {
+        int left = -1, right = -1, parent = -1;
+        int height = 0;                  // 0 - лист
+        int minLeaf = -1, maxLeaf = -1;  // крайние листья поддерева
+        Bridge bridge[2];                // верхний и нижний мосты
+        Point point;                     // только у листа
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int root = -1;
+    std::size_t count = 0;
+
+    int newNode();
+    int buildBalanced(const std::vector<int>& leaves, std::size_t begin, std::size_t end);
+    bool isLeaf(int v) const { return nodes[v].left < 0; }
+    bool less(int a, int b) const;
+
+    void attach(int leaf);
+    void detach(int leaf);
+    void replaceChild(int parent, int from, int to);
+    void update(int v);
+    int rotate(int v, bool toLeft);
+    void rebalance(int v);
+
+    // Нижняя оболочка считается как верхняя после поворота плоскости на 180 градусов
+    Point framed(int leaf, Side side) const;
+    int child(int v, bool first, Side side) const;
+    bool before(int a, int b, Side side) const;
+    void narrow(int& v, int lo, int hi, Side side) const;
+    Bridge findBridge(int v, Side side) const;
+    void collect(int v, int lo, int hi, Side side, std::vector<Point>& out) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef POINT_HPP
+#define POINT_HPP
+
+namespace Task5 {
+
+// Точка алгоритмов оболочки; без зависимости от Qt, чтобы алгоритмы
+// собирались отдельной библиотекой (преобразование в QPointF - во вьюере)
+struct Point {
+    double x, y;
+    Point(double x = 0, double y = 0) : x(x), y(y) {}
+
+    bool operator<(const Point& p) const {
+        return x < p.x || (x == p.x && y < p.y);
+    }
+};
+
+}
+
+#endif
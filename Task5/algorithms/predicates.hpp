@@ -0,0 +1,16 @@
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+
+#include "point.hpp"
+
+namespace Task5 {
+
+// Предикат ориентации с адаптивной точностью (по Шевчуку): обычно одно
+// вычисление в double с оценкой погрешности, точная арифметика разложений -
+// только если знак по оценке не гарантирован.
+// > 0: тройка a, b, c против часовой стрелки (c слева от ab), < 0 - по часовой, 0 - на одной прямой
+double orient2d(const Point& a, const Point& b, const Point& c);
+
+}
+
+#endif
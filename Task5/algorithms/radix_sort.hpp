@@ -0,0 +1,116 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Task5 {
+
+// Ключ, монотонный по значению double: у неотрицательных чисел выставляется
+// знаковый бит, у отрицательных инвертируются все биты. -0.0 и +0.0 дают
+// один ключ, как и при сравнении double
+inline std::uint64_t orderedKey(double v) {
+    v += 0.0;   // -0.0 -> +0.0
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+}
+
+// Устойчивая сортировка слиянием items[0..n) через buffer того же размера:
+// серии по 32 элемента сортируются вставками, затем сливаются снизу вверх
+template <class T, class Less>
+void mergeSortWithBuffer(T* items, std::size_t n, T* buffer, Less less) {
+    const std::size_t run = 32;
+    for (std::size_t lo = 0; lo < n; lo += run) {
+        const std::size_t hi = std::min(lo + run, n);
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            T item = items[i];
+            std::size_t j = i;
+            for (; j > lo && less(item, items[j - 1]); --j) items[j] = items[j - 1];
+            items[j] = item;
+        }
+    }
+
+    T* from = items;
+    T* to = buffer;
+    for (std::size_t width = run; width < n; width *= 2) {
+        for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+            const std::size_t mid = std::min(lo + width, n);
+            const std::size_t hi = std::min(lo + 2 * width, n);
+            std::merge(from + lo, from + mid, from + mid, from + hi, to + lo, less);
+        }
+        std::swap(from, to);
+    }
+    if (from != items) std::copy(from, from + n, items);
+}
+
+// Устойчивая сортировка items[0..n) по точке pointOf(item) в порядке (x, y);
+// buffer - рабочий массив на n элементов. Большие наборы сортируются поразрядно
+// (LSD, разряды по 16 бит) по ключам x, затем серии с равным x досортировываются
+// по y; малые - слиянием. Куча нужна только гистограммам больших наборов
+template <class T, class PointOf>
+void radixSortByPoint(T* items, std::size_t n, T* buffer, PointOf pointOf) {
+    if (n < (std::size_t(1) << 16)) {
+        mergeSortWithBuffer(items, n, buffer, [&](const T& a, const T& b) {
+            const auto& p = pointOf(a);
+            const auto& q = pointOf(b);
+            return p.x < q.x || (p.x == q.x && p.y < q.y);
+        });
+        return;
+    }
+
+    const int bits = 16;
+    const int digits = 64 / bits;
+    const std::size_t buckets = std::size_t(1) << bits;
+    auto digitOf = [&](const T& item, int d) {
+        return (orderedKey(pointOf(item).x) >> (d * bits)) & (buckets - 1);
+    };
+
+    // Гистограммы всех разрядов за один проход
+    std::vector<std::uint32_t> counts(digits * buckets, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t key = orderedKey(pointOf(items[i]).x);
+        for (int d = 0; d < digits; ++d) ++counts[d * buckets + ((key >> (d * bits)) & (buckets - 1))];
+    }
+
+    T* from = items;
+    T* to = buffer;
+    for (int d = 0; d < digits; ++d) {
+        std::uint32_t* next = counts.data() + d * buckets;
+        if (next[digitOf(from[0], d)] == n) continue;   // разряд у всех одинаковый
+
+        std::uint32_t offset = 0;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            std::uint32_t size = next[b];
+            next[b] = offset;
+            offset += size;
+        }
+        for (std::size_t i = 0; i < n; ++i) to[next[digitOf(from[i], d)]++] = from[i];
+        std::swap(from, to);
+    }
+    if (from != items) std::copy(from, from + n, items);
+
+    for (std::size_t i = 0; i < n; ) {
+        std::size_t j = i + 1;
+        while (j < n && pointOf(items[j]).x == pointOf(items[i]).x) ++j;
+        if (j - i > 1) {
+            mergeSortWithBuffer(items + i, j - i, buffer, [&](const T& a, const T& b) {
+                return pointOf(a).y < pointOf(b).y;
+            });
+        }
+        i = j;
+    }
+}
+
+// То же для вектора; рабочий буфер выделяется здесь
+template <class T, class PointOf>
+void radixSortByPoint(std::vector<T>& items, PointOf pointOf) {
+    std::vector<T> buffer(items.size());
+    radixSortByPoint(items.data(), items.size(), buffer.data(), pointOf);
+}
+
+}
+
+#endif
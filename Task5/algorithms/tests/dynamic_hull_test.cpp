@@ -0,0 +1,105 @@
+// DynamicConvexHull против ConvexHull::compute с нуля после каждой правки:
+// случайные добавления, удаления и перемещения, в том числе совпадающих и
+// коллинеарных точек (решетка с целыми координатами)
+#include "dynamic_hull.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Task5;
+
+namespace {
+
+int failures = 0;
+
+// ConvexHull::compute возвращает меньше трех точек как есть, а совпавшие
+// точки - повторами; у динамической оболочки вырожденный ответ упорядочен
+std::vector<Point> reference(const std::vector<Point>& points) {
+    std::vector<Point> hull = ConvexHull::compute(points);
+    if (hull.size() < 3) {
+        std::sort(hull.begin(), hull.end());
+        hull.erase(std::unique(hull.begin(), hull.end(),
+                               [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }),
+                   hull.end());
+    }
+    return hull;
+}
+
+bool sameHull(const std::vector<Point>& a, const std::vector<Point>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (a[i].x != b[i].x || a[i].y != b[i].y) return false;
+    return true;
+}
+
+template <class Coord>
+void run(const char* kind, int seed, int initial, int edits, Coord coord) {
+    std::mt19937 rng(seed);
+    std::vector<Point> points;
+    for (int i = 0; i < initial; ++i) points.push_back(coord(rng));
+
+    DynamicConvexHull hull;
+    hull.assign(points);
+    std::vector<int> handles(points.size());
+    for (std::size_t i = 0; i < handles.size(); ++i) handles[i] = (int)i;
+
+    for (int e = 0; e < edits; ++e) {
+        int op = rng() % 3;
+        if (op == 0 || points.empty()) {
+            points.push_back(coord(rng));
+            handles.push_back(hull.insert(points.back()));
+        } else {
+            std::size_t i = rng() % points.size();
+            if (op == 1) {
+                hull.remove(handles[i]);
+                points[i] = points.back();
+                handles[i] = handles.back();
+                points.pop_back();
+                handles.pop_back();
+            } else {
+                points[i] = rng() % 4 ? coord(rng) : points[rng() % points.size()];
+                hull.move(handles[i], points[i]);
+            }
+        }
+
+        std::vector<Point> expected = reference(points);
+        std::vector<Point> actual = hull.hull();
+        if (hull.size() != points.size() || !sameHull(actual, expected)) {
+            std::printf("%s seed %d, edit %d: %zu of %zu points, %zu hull vertices, expected %zu\n",
+                        kind, seed, e, hull.size(), points.size(), actual.size(), expected.size());
+            ++failures;
+            return;
+        }
+    }
+}
+
+}
+
+int main() {
+    for (int seed = 0; seed < 100; ++seed) {
+        std::uniform_real_distribution<double> u(0, 1000);
+        run("random", seed, seed % 50, 500, [&](std::mt19937& rng) { return Point(u(rng), u(rng)); });
+    }
+    for (int seed = 0; seed < 100; ++seed) {
+        std::uniform_int_distribution<int> g(0, 6);
+        run("grid", seed, seed % 20, 500, [&](std::mt19937& rng) { return Point(g(rng), g(rng)); });
+    }
+    for (int seed = 0; seed < 20; ++seed) {
+        // Точки на окружности и внутри нее: оболочка из сотен вершин
+        std::uniform_real_distribution<double> angle(0, 2 * M_PI), radius(0, 400);
+        run("circle", seed, 1000, 500, [&](std::mt19937& rng) {
+            double t = angle(rng), r = rng() % 2 ? 400 : radius(rng);
+            return Point(500 + r * std::cos(t), 500 + r * std::sin(t));
+        });
+    }
+
+    if (failures) {
+        std::printf("%d failures\n", failures);
+        return 1;
+    }
+    std::printf("ok\n");
+    return 0;
+}
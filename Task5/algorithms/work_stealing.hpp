@@ -0,0 +1,96 @@
+#ifndef WORK_STEALING_HPP
+#define WORK_STEALING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Task5 {
+
+// Параллельный цикл по индексам [0, count) с перехватом работы.
+// Диапазон сначала делится поровну между потоками; каждый поток берет из
+// начала своего диапазона порции по grain индексов и передает их в
+// body(begin, end). Опустевший поток забирает у соседа вторую половину
+// его остатка и продолжает с ней, так что неравные по цене элементы не
+// оставляют потоки без дела. threads == 0 - по числу ядер
+template <class F>
+void parallelFor(std::size_t count, unsigned threads, std::size_t grain, F body) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, (count + grain - 1) / grain));
+    if (threads <= 1) {
+        body(std::size_t(0), count);
+        return;
+    }
+
+    struct Range {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+    std::vector<Range> ranges(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        ranges[t].begin = count * t / threads;
+        ranges[t].end = count * (t + 1) / threads;
+    }
+
+    auto worker = [&](unsigned self) {
+        Range& own = ranges[self];
+        for (;;) {
+            std::size_t begin = 0, end = 0;
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (own.begin < own.end) {
+                    begin = own.begin;
+                    end = std::min(own.end, begin + grain);
+                    own.begin = end;
+                }
+            }
+            if (begin < end) {
+                body(begin, end);
+                continue;
+            }
+
+            // Свой диапазон пуст - перехват. Чужой замок отпускается до
+            // захвата своего, поэтому два вора не ждут друг друга
+            for (unsigned k = 1; k < threads && begin == end; ++k) {
+                Range& victim = ranges[(self + k) % threads];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin < victim.end) {
+                    begin = victim.begin + (victim.end - victim.begin) / 2;
+                    end = victim.end;
+                    victim.end = begin;
+                }
+            }
+            if (begin == end) {
+                return;   // остатки есть только у занятых потоков, они их и доделают
+            }
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin;
+            own.end = end;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+}
+
+#endif
@@ -9,6 +9,15 @@
 #include <QCheckBox>
 #include <QWidget>
 
+using Task5::Point;
+
+namespace {
+
+QPointF toQPointF(const Point& p) { return QPointF(p.x, p.y); }
+Point toPoint(const QPointF& p) { return Point(p.x(), p.y()); }
+
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
@@ -56,14 +65,14 @@ void MainWindow::paintEvent(QPaintEvent *event)
     painter.setRenderHint(QPainter::Antialiasing);
 
     for (const auto& point : points) {
-        drawPoint(painter, point.toQPointF());
+        drawPoint(painter, toQPointF(point));
     }
 
     if (showHull && convexHull.size() >= 2) {
         drawHull(painter);
 
         for (const auto& point : convexHull) {
-            drawPoint(painter, point.toQPointF(), true);
+            drawPoint(painter, toQPointF(point), true);
         }
     }
 }
@@ -94,10 +103,10 @@ void MainWindow::drawHull(QPainter& painter)
 
     QPolygonF polygon;
     for (const auto& point : convexHull) {
-        polygon << point.toQPointF();
+        polygon << toQPointF(point);
     }
     if (!convexHull.empty()) {
-        polygon << convexHull[0].toQPointF();
+        polygon << toQPointF(convexHull[0]);
     }
 
     painter.drawPolyline(polygon);
@@ -114,9 +123,10 @@ void MainWindow::mousePressEvent(QMouseEvent *event)
         if (pointIndex != -1) {
             dragging = true;
             draggedPointIndex = pointIndex;
-            dragStartPos = points[pointIndex].toQPointF();
+            dragStartPos = toQPointF(points[pointIndex]);
         } else {
-            points.push_back(Point(pos));
+            points.push_back(toPoint(pos));
+            hullHandles.push_back(dynamicHull.insert(points.back()));
 
             if (onlineMode && showHull) {
                 updateHull();
@@ -133,7 +143,8 @@ void MainWindow::mouseMoveEvent(QMouseEvent *event)
         return;
     }
 
-    points[draggedPointIndex] = Point(event->pos());
+    points[draggedPointIndex] = toPoint(event->pos());
+    dynamicHull.move(hullHandles[draggedPointIndex], points[draggedPointIndex]);
 
     if (onlineMode && showHull) {
         updateHull();
@@ -158,7 +169,7 @@ void MainWindow::mouseReleaseEvent(QMouseEvent *event)
 int MainWindow::findPointNear(const QPointF& pos, double threshold)
 {
     for (size_t i = 0; i < points.size(); ++i) {
-        QPointF pointPos = points[i].toQPointF();
+        QPointF pointPos = toQPointF(points[i]);
         if (qAbs(pointPos.x() - pos.x()) < threshold && qAbs(pointPos.y() - pos.y()) < threshold) {
             return (int)i;
         }
@@ -168,7 +179,7 @@ int MainWindow::findPointNear(const QPointF& pos, double threshold)
 
 void MainWindow::updateHull()
 {
-    convexHull = ConvexHull::compute(points);
+    convexHull = dynamicHull.hull();
 }
 
 void MainWindow::onBuildHullClicked()
@@ -186,6 +197,8 @@ void MainWindow::onClearClicked()
 {
     points.clear();
     convexHull.clear();
+    dynamicHull.clear();
+    hullHandles.clear();
     showHull = false;
     update();
 }
@@ -5,6 +5,7 @@
 #include <QPointF>
 #include <vector>
 #include "algorithms/convex_hull.hpp"
+#include "algorithms/dynamic_hull.hpp"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -34,8 +35,10 @@ private slots:
 private:
     Ui::MainWindow *ui;
 
-    std::vector<Point> points;
-    std::vector<Point> convexHull;
+    std::vector<Task5::Point> points;
+    std::vector<Task5::Point> convexHull;
+    Task5::DynamicConvexHull dynamicHull;   // обновляется при каждой правке точек
+    std::vector<int> hullHandles;    // дескриптор в dynamicHull для каждой точки
 
     bool dragging = false;
     int draggedPointIndex = -1;
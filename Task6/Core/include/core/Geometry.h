@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <array>
 
 struct Point {
     double x;
@@ -20,9 +21,26 @@ struct Triangle {
     }
 };
 
+// Индексная сетка: треугольники хранят индексы вершин, соседство - индексы треугольников
+struct DelaunayMesh {
+    std::vector<Point> vertices;
+    std::vector<std::array<int, 3>> triangles;  // вершины против часовой стрелки
+    std::vector<std::array<int, 3>> neighbors;  // сосед через ребро напротив triangles[t][i], -1 если нет
+};
 
 class Geometry {
 public:
     // Возвращает вектор треугольников для триангуляции Делоне
     static std::vector<Triangle> delaunayTriangulation(const std::vector<Point>& points);
+
+    // Та же триангуляция в индексном виде; индексы вершин совпадают с индексами входных точек
+    // (у совпадающих точек - индекс первой). Сетка покрывает всю выпуклую оболочку:
+    // соседа (-1) нет только у ребер оболочки
+    static DelaunayMesh delaunayMesh(const std::vector<Point>& points);
+
+    // Параллельный "разделяй и властвуй" (Guibas-Stolfi): полосы отсортированных точек
+    // триангулируются в отдельных потоках и сшиваются. threads = 0 - по числу ядер.
+    // Совпадает с delaunayMesh с точностью до диагоналей у точек на одной окружности.
+    static DelaunayMesh delaunayMeshParallel(const std::vector<Point>& points, unsigned threads = 0);
+    static std::vector<Triangle> delaunayTriangulationParallel(const std::vector<Point>& points, unsigned threads = 0);
 };
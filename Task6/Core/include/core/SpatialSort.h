@@ -0,0 +1,20 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "core/Geometry.h"
+
+// Пространственно согласованный порядок обхода точек.
+// Функции возвращают перестановку индексов входного массива и не меняют сами точки,
+// поэтому подходят любому алгоритму, которому выгодна локальность по памяти.
+
+// Индекс на кривой Гильберта порядка 16 для точки в ограничивающем прямоугольнике
+std::uint32_t hilbertIndex(const Point& p, double minX, double minY, double scaleX, double scaleY);
+
+// Точки вдоль кривой Гильберта
+std::vector<std::size_t> hilbertOrder(const std::vector<Point>& points);
+
+// BRIO (Biased Randomized Insertion Order): точки разбиваются на случайные раунды
+// (последний раунд - примерно половина точек, предыдущий - четверть и т.д.),
+// раунды идут от малого к большому, внутри раунда - вдоль кривой Гильберта
+std::vector<std::size_t> brioOrder(const std::vector<Point>& points, unsigned seed = 0);
@@ -0,0 +1,152 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "core/Geometry.h"
+
+// Инкрементальная триангуляция Делоне (Bowyer-Watson) на связях соседства.
+// Точка локализуется прогулкой по соседям, полость "плохих" треугольников
+// ищется обходом от найденного треугольника, так что вставка затрагивает
+// только локальную окрестность новой точки. Объект можно хранить между
+// правками: удаление и перемещение вершины чинят триангуляцию флипами рёбер.
+//
+// Вершины супер-треугольника символические: s0 = (-M^2, -M), s1 = (2M^2, -M),
+// s2 = (M, M^3) при M -> бесконечности. Предикаты с ними берут знак старшего
+// коэффициента многочлена от M, поэтому супер-треугольник содержит любую
+// конечную точку и не попадает ни в одну описанную окружность настоящих
+// вершин: треугольники без его вершин - вся триангуляция Делоне, включая
+// треугольники у выпуклой оболочки.
+class Triangulation {
+public:
+    static constexpr int None = -1;
+
+    struct Face {
+        int v[3];      // вершины против часовой стрелки
+        int n[3];      // n[i] - сосед через ребро, противолежащее v[i]
+        bool alive;
+    };
+
+    Triangulation();
+
+    // Триангуляция набора точек в порядке BRIO; в ids - индекс вершины для каждой точки
+    static Triangulation build(const std::vector<Point>& points, std::vector<int>* ids = nullptr);
+
+    // Возвращает индекс вершины (или уже существующей совпадающей),
+    // None - если у точки не конечные координаты
+    int insert(const Point& p);
+
+    // Удаляет вершину; индексы остальных вершин не меняются
+    bool remove(int v);
+
+    // Переносит вершину в p с сохранением индекса. false - если у точки не
+    // конечные координаты или она совпала с другой вершиной: тогда вершина
+    // остается вне триангуляции до следующего успешного move()
+    bool move(int v, const Point& p);
+
+    // Вершина участвует в триангуляции (не удалена и не совпала с другой)
+    bool contains(int v) const { return m_vertexFace[v + SuperVertices] != None; }
+
+    void reserve(std::size_t points);
+
+    // Треугольники без вершин супер-треугольника
+    std::vector<Triangle> triangles() const;
+
+    template <class F>
+    void forEachTriangle(F f) const {
+        for (const Face& face : m_faces) {
+            if (!face.alive) continue;
+            if (face.v[0] < SuperVertices || face.v[1] < SuperVertices || face.v[2] < SuperVertices)
+                continue;
+            f(m_vertices[face.v[0]], m_vertices[face.v[1]], m_vertices[face.v[2]]);
+        }
+    }
+
+    // Ребра диаграммы Вороного по текущей триангуляции, без toMesh() и
+    // voronoiDiagram(): центры описанных окружностей уже хранятся. segment(a, b) -
+    // ребро между центрами соседних треугольников, ray(a, direction) - луч
+    // наружу через ребро выпуклой оболочки, как в VoronoiDiagram
+    template <class Segment, class Ray>
+    void forEachVoronoiEdge(Segment segment, Ray ray) const {
+        auto isReal = [&](const Face& face) {
+            return face.alive && face.v[0] >= SuperVertices && face.v[1] >= SuperVertices &&
+                   face.v[2] >= SuperVertices;
+        };
+        for (int t = 0; t < (int)m_faces.size(); ++t) {
+            const Face& face = m_faces[t];
+            if (!isReal(face)) continue;
+            for (int i = 0; i < 3; ++i) {
+                int nb = face.n[i];
+                if (nb != None && isReal(m_faces[nb])) {
+                    if (nb > t) segment(m_circles[t].center, m_circles[nb].center);
+                } else {
+                    const Point& a = m_vertices[face.v[(i + 1) % 3]];
+                    const Point& b = m_vertices[face.v[(i + 2) % 3]];
+                    ray(m_circles[t].center, Point{b.y - a.y, a.x - b.x});
+                }
+            }
+        }
+    }
+
+    // Индексная сетка без супер-треугольника; индексы вершин - как вернул insert()
+    DelaunayMesh toMesh() const;
+
+    std::size_t vertexCount() const { return m_vertices.size() - SuperVertices; }
+    const Point& vertex(int v) const { return m_vertices[v + SuperVertices]; }
+
+private:
+    static constexpr int SuperVertices = 3;
+
+    // Описанная окружность треугольника, radius2 - квадрат расстояния от v[0]
+    // до center. Пока квадрат расстояния от точки до center отличается от
+    // radius2 больше чем на tolerance (оценка ошибок в updateCircle), знак
+    // сравнения совпадает со знаком incircle; иначе решает точный предикат
+    struct Circle {
+        Point  center;
+        double radius2;
+        double tolerance;
+    };
+
+    std::vector<Point> m_vertices;   // первые три - символический супер-треугольник (NaN)
+    std::vector<int>   m_vertexFace; // какой-нибудь треугольник с этой вершиной, None - вершины нет
+    std::vector<Face>  m_faces;
+    std::vector<unsigned> m_stamp;   // метка "плохого" треугольника текущей вставки
+    std::vector<Circle> m_circles;   // описанные окружности, параллельно m_faces
+    std::vector<int>   m_freeFaces;
+    int      m_lastFace{None};
+    unsigned m_currentStamp{0};
+
+    struct BoundaryEdge {
+        int a, b;
+        int outer;       // внешний сосед (или None)
+        int outerSlot;   // индекс ребра во внешнем соседе
+    };
+
+    struct EdgeRef {
+        int face;
+        int slot;        // ребро напротив face.v[slot]
+    };
+
+    // Рабочие буферы, переиспользуемые между вставками
+    std::vector<int> m_cavity;
+    std::vector<int> m_stack;
+    std::vector<BoundaryEdge> m_boundary;
+    std::unordered_map<int, int> m_faceByStart;
+    std::vector<EdgeRef> m_flipQueue;
+
+    int  locate(const Point& p) const;
+    // Знак orient2d по индексам вершин с учетом символических
+    int  orientSign(int a, int b, int c) const;
+    int  orientSign(int a, int b, const Point& p) const;
+    // p - настоящая точка; треугольник может содержать символические вершины
+    bool inCircumCircle(int face, const Point& p) const;
+    int  newFace(int a, int b, int c);
+    void updateCircle(int face);
+    void freeFace(int face);
+
+    void insertVertex(int vi, int start);  // вставка записанной в m_vertices вершины, start - содержащий ее треугольник
+    void detachVertex(int vi);             // убирает вершину из триангуляции
+    void rebuild();                        // заново вставляет все вершины, индексы сохраняются
+    int  slotOf(int face, int vertex) const;
+    void replaceNeighbor(int face, int from, int to);
+    void flip(int face, int slot);
+    void legalize();                       // флипы Лоусона по очереди m_flipQueue
+};
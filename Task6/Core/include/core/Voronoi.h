@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include "core/Geometry.h"
+
+// Диаграмма Вороного как двойственный граф триангуляции Делоне
+struct VoronoiDiagram {
+    // Вершины - центры описанных окружностей, vertices[t] для треугольника t сетки
+    std::vector<Point> vertices;
+
+    // Ребро между вершинами a и b; для b == -1 это луч из vertices[a] в направлении direction
+    struct Edge {
+        int a;
+        int b;
+        Point direction;
+    };
+    std::vector<Edge> edges;
+
+    // Ячейка сайта i: cellVertices[cellOffsets[i] .. cellOffsets[i + 1]) против часовой стрелки.
+    // У незамкнутой ячейки (сайт на границе сетки) первая и последняя вершины - начала лучей.
+    std::vector<int>  cellOffsets;
+    std::vector<int>  cellVertices;
+    std::vector<char> cellClosed;
+};
+
+// Строится за O(n) по соседству треугольников сетки без повторной триангуляции
+VoronoiDiagram voronoiDiagram(const DelaunayMesh& mesh);
@@ -0,0 +1,299 @@
+#include "core/Geometry.h"
+#include "core/Predicates.h"
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Триангуляция Делоне "разделяй и властвуй" (Guibas-Stolfi) на quad-edge.
+// Верхние уровни рекурсии выполняются в отдельных потоках; каждая задача
+// создает ребра в собственном пуле, поэтому синхронизация нужна только при
+// заведении нового пула. Разбиение не зависит от числа потоков, так что
+// результат одинаков при любом их количестве.
+
+namespace {
+
+constexpr std::size_t ParallelThreshold = 1 << 13;  // меньшие полосы - в текущем потоке
+
+struct Edge {
+    Edge* onext;
+    int   org;     // индекс вершины (для дуальных ребер не используется)
+    int   face;    // треугольник слева (заполняется при выгрузке)
+    int   index;   // номер ребра в четверке
+
+    Edge* rot()    { return this - index + ((index + 1) & 3); }
+    Edge* invRot() { return this - index + ((index + 3) & 3); }
+    Edge* sym()    { return this - index + ((index + 2) & 3); }
+    Edge* oprev()  { return rot()->onext->rot(); }
+    Edge* lnext()  { return invRot()->onext->rot(); }
+    Edge* rprev()  { return sym()->onext; }
+    int   dest()   { return sym()->org; }
+};
+
+struct QuadEdge {
+    Edge e[4];
+    bool alive;
+};
+
+using Arena = std::deque<QuadEdge>;
+
+class DivideAndConquer {
+public:
+    // Вершины ребер - номера точек в отсортированном массиве
+    explicit DivideAndConquer(std::vector<Point> sortedPoints)
+        : m_points(std::move(sortedPoints)) {}
+
+    void run(unsigned threads) {
+        int depth = 0;
+        while ((1u << depth) < threads) ++depth;
+        if (m_points.size() >= 2) solve(newArena(), 0, (int)m_points.size(), depth);
+    }
+
+    template <class F>
+    void forEachEdge(F f) {
+        for (Arena& arena : m_arenas)
+            for (QuadEdge& q : arena)
+                if (q.alive) f(&q.e[0]);
+    }
+
+    const Point& pt(int v) const { return m_points[v]; }
+
+private:
+    std::vector<Point> m_points;   // различные точки по возрастанию (x, y)
+    std::deque<Arena> m_arenas;
+    std::mutex        m_arenasMutex;
+
+    Arena& newArena() {
+        std::lock_guard<std::mutex> lock(m_arenasMutex);
+        return m_arenas.emplace_back();
+    }
+
+    double ccw(int a, int b, int c) const {
+        return orient2d(m_points[a], m_points[b], m_points[c]);
+    }
+
+    // d внутри окружности, проходящей через a, b, c (против часовой)
+    bool inCircle(int a, int b, int c, int d) const {
+        return incircle(m_points[a], m_points[b], m_points[c], m_points[d]) > 0;
+    }
+
+    bool rightOf(int p, Edge* e) const { return ccw(p, e->dest(), e->org) > 0; }
+    bool leftOf(int p, Edge* e) const  { return ccw(p, e->org, e->dest()) > 0; }
+
+    static Edge* makeEdge(Arena& arena, int a, int b) {
+        QuadEdge& q = arena.emplace_back();
+        q.alive = true;
+        for (int i = 0; i < 4; ++i) {
+            q.e[i].index = i;
+            q.e[i].face  = -1;
+            q.e[i].org   = -1;
+        }
+        q.e[0].onext = &q.e[0];
+        q.e[1].onext = &q.e[3];
+        q.e[2].onext = &q.e[2];
+        q.e[3].onext = &q.e[1];
+        q.e[0].org = a;
+        q.e[2].org = b;
+        return &q.e[0];
+    }
+
+    static void splice(Edge* a, Edge* b) {
+        Edge* alpha = a->onext->rot();
+        Edge* beta  = b->onext->rot();
+        std::swap(a->onext, b->onext);
+        std::swap(alpha->onext, beta->onext);
+    }
+
+    static Edge* connect(Arena& arena, Edge* a, Edge* b) {
+        Edge* e = makeEdge(arena, a->dest(), b->org);
+        splice(e, a->lnext());
+        splice(e->sym(), b);
+        return e;
+    }
+
+    static void deleteEdge(Edge* e) {
+        splice(e, e->oprev());
+        splice(e->sym(), e->sym()->oprev());
+        reinterpret_cast<QuadEdge*>(e - e->index)->alive = false;
+    }
+
+    // Возвращает самое левое ребро против часовой и самое правое по часовой оболочки
+    std::pair<Edge*, Edge*> solve(Arena& arena, int lo, int hi, int depth) {
+        const int n = hi - lo;
+
+        if (n == 2) {
+            Edge* a = makeEdge(arena, lo, lo + 1);
+            return {a, a->sym()};
+        }
+        if (n == 3) {
+            Edge* a = makeEdge(arena, lo, lo + 1);
+            Edge* b = makeEdge(arena, lo + 1, lo + 2);
+            splice(a->sym(), b);
+            double o = ccw(lo, lo + 1, lo + 2);
+            if (o > 0) {
+                connect(arena, b, a);
+                return {a, b->sym()};
+            }
+            if (o < 0) {
+                Edge* c = connect(arena, b, a);
+                return {c->sym(), c};
+            }
+            return {a, b->sym()};  // три точки на одной прямой
+        }
+
+        const int mid = lo + n / 2;
+        std::pair<Edge*, Edge*> left, right;
+        if (depth > 0 && (std::size_t)n >= ParallelThreshold) {
+            Arena& leftArena = newArena();
+            auto task = std::async(std::launch::async, [&] { return solve(leftArena, lo, mid, depth - 1); });
+            right = solve(arena, mid, hi, depth - 1);
+            left = task.get();
+        } else {
+            left  = solve(arena, lo, mid, 0);
+            right = solve(arena, mid, hi, 0);
+        }
+
+        Edge* ldo = left.first;
+        Edge* ldi = left.second;
+        Edge* rdi = right.first;
+        Edge* rdo = right.second;
+
+        // Нижняя общая касательная
+        for (;;) {
+            if (leftOf(rdi->org, ldi)) ldi = ldi->lnext();
+            else if (rightOf(ldi->org, rdi)) rdi = rdi->rprev();
+            else break;
+        }
+
+        Edge* basel = connect(arena, rdi->sym(), ldi);
+        if (ldi->org == ldo->org) ldo = basel->sym();
+        if (rdi->org == rdo->org) rdo = basel;
+
+        // Сшивание полос снизу вверх
+        for (;;) {
+            Edge* lcand = basel->sym()->onext;
+            bool lvalid = rightOf(lcand->dest(), basel);
+            if (lvalid) {
+                while (inCircle(basel->dest(), basel->org, lcand->dest(), lcand->onext->dest())) {
+                    Edge* t = lcand->onext;
+                    deleteEdge(lcand);
+                    lcand = t;
+                }
+            }
+
+            Edge* rcand = basel->oprev();
+            bool rvalid = rightOf(rcand->dest(), basel);
+            if (rvalid) {
+                while (inCircle(basel->dest(), basel->org, rcand->dest(), rcand->oprev()->dest())) {
+                    Edge* t = rcand->oprev();
+                    deleteEdge(rcand);
+                    rcand = t;
+                }
+            }
+
+            lvalid = rightOf(lcand->dest(), basel);
+            rvalid = rightOf(rcand->dest(), basel);
+            if (!lvalid && !rvalid) break;
+
+            if (!lvalid || (rvalid && inCircle(lcand->dest(), lcand->org, rcand->org, rcand->dest())))
+                basel = connect(arena, rcand, basel->sym());
+            else
+                basel = connect(arena, basel->sym(), lcand->sym());
+        }
+        return {ldo, rdo};
+    }
+};
+
+bool lexLess(const Point& a, const Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Параллельная сортировка слиянием; разбиение фиксировано, результат детерминирован
+void parallelSort(const std::vector<Point>& points, std::vector<int>::iterator first,
+                  std::vector<int>::iterator last, int depth) {
+    auto less = [&](int a, int b) {
+        if (lexLess(points[a], points[b])) return true;
+        if (lexLess(points[b], points[a])) return false;
+        return a < b;
+    };
+    if (depth <= 0 || (std::size_t)(last - first) < ParallelThreshold) {
+        std::sort(first, last, less);
+        return;
+    }
+    auto mid = first + (last - first) / 2;
+    auto task = std::async(std::launch::async, [&] { parallelSort(points, first, mid, depth - 1); });
+    parallelSort(points, mid, last, depth - 1);
+    task.get();
+    std::inplace_merge(first, mid, last, less);
+}
+
+} // namespace
+
+DelaunayMesh Geometry::delaunayMeshParallel(const std::vector<Point>& points, unsigned threads) {
+    DelaunayMesh mesh;
+    mesh.vertices = points;
+    if (points.size() < 3) return mesh;
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((1u << depth) < threads) ++depth;
+
+    // Сортировка по (x, y); из совпадающих точек остается первая по индексу
+    std::vector<int> sorted(points.size());
+    for (int i = 0; i < (int)sorted.size(); ++i) sorted[i] = i;
+    parallelSort(points, sorted.begin(), sorted.end(), depth);
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [&](int a, int b) {
+        return points[a] == points[b];
+    }), sorted.end());
+
+    std::vector<Point> sortedPoints;
+    sortedPoints.reserve(sorted.size());
+    for (int i : sorted) sortedPoints.push_back(points[i]);
+
+    DivideAndConquer dc(std::move(sortedPoints));
+    dc.run(threads);
+
+    // Треугольник выгружается с ребра, выходящего из его наименьшей вершины;
+    // затем треугольники упорядочиваются по вершинам, чтобы порядок не зависел от потоков
+    struct Face { int v[3]; Edge* e[3]; };
+    std::vector<Face> faces;
+    dc.forEachEdge([&](Edge* e) {
+        for (Edge* d : {e, e->sym()}) {
+            Edge* b = d->lnext();
+            Edge* c = b->lnext();
+            if (c->lnext() != d) continue;
+            int v0 = d->org, v1 = b->org, v2 = c->org;
+            if (v0 > v1 || v0 > v2) continue;
+            if (orient2d(dc.pt(v0), dc.pt(v1), dc.pt(v2)) <= 0) continue;  // внешняя грань
+            faces.push_back({{v0, v1, v2}, {d, b, c}});
+        }
+    });
+    std::sort(faces.begin(), faces.end(), [](const Face& a, const Face& b) {
+        return a.v[0] != b.v[0] ? a.v[0] < b.v[0] : a.v[1] < b.v[1];
+    });
+
+    mesh.triangles.reserve(faces.size());
+    mesh.neighbors.reserve(faces.size());
+    for (int t = 0; t < (int)faces.size(); ++t) {
+        for (Edge* e : faces[t].e) e->face = t;
+        const int* v = faces[t].v;
+        mesh.triangles.push_back({sorted[v[0]], sorted[v[1]], sorted[v[2]]});
+    }
+    // Сосед напротив v[i] лежит слева от противоположно направленного ребра (v[i+1], v[i+2])
+    for (const Face& f : faces) {
+        mesh.neighbors.push_back({f.e[1]->sym()->face, f.e[2]->sym()->face, f.e[0]->sym()->face});
+    }
+    return mesh;
+}
+
+std::vector<Triangle> Geometry::delaunayTriangulationParallel(const std::vector<Point>& points, unsigned threads) {
+    DelaunayMesh mesh = delaunayMeshParallel(points, threads);
+    std::vector<Triangle> result;
+    result.reserve(mesh.triangles.size());
+    for (const auto& t : mesh.triangles) {
+        result.push_back({points[t[0]], points[t[1]], points[t[2]]});
+    }
+    return result;
+}
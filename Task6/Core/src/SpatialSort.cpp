@@ -0,0 +1,103 @@
+#include "core/SpatialSort.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+
+namespace {
+
+constexpr int HilbertOrder = 16;
+constexpr double HilbertCells = double(1u << HilbertOrder) - 1;
+
+// Ограничивающий прямоугольник и масштаб на сетку 2^16 x 2^16
+struct Grid {
+    double minX, minY, scaleX, scaleY;
+};
+
+Grid makeGrid(const std::vector<Point>& points) {
+    double minX = points[0].x, maxX = points[0].x;
+    double minY = points[0].y, maxY = points[0].y;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    double dx = maxX - minX, dy = maxY - minY;
+    return {minX, minY, dx > 0 ? HilbertCells / dx : 0.0, dy > 0 ? HilbertCells / dy : 0.0};
+}
+
+// Сортирует индексы [first, last) по индексу Гильберта
+void sortByHilbert(const std::vector<Point>& points, const Grid& g,
+                   std::vector<std::size_t>::iterator first,
+                   std::vector<std::size_t>::iterator last) {
+    std::vector<std::pair<std::uint32_t, std::size_t>> keys;
+    keys.reserve(last - first);
+    for (auto it = first; it != last; ++it)
+        keys.push_back({hilbertIndex(points[*it], g.minX, g.minY, g.scaleX, g.scaleY), *it});
+    std::sort(keys.begin(), keys.end());
+    for (const auto& k : keys) *first++ = k.second;
+}
+
+} // namespace
+
+std::uint32_t hilbertIndex(const Point& p, double minX, double minY, double scaleX, double scaleY) {
+    std::uint32_t x = (std::uint32_t)((p.x - minX) * scaleX);
+    std::uint32_t y = (std::uint32_t)((p.y - minY) * scaleY);
+
+    // Классическое преобразование (x, y) -> d с поворотом квадрантов
+    std::uint32_t d = 0;
+    for (std::uint32_t s = 1u << (HilbertOrder - 1); s > 0; s >>= 1) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+std::vector<std::size_t> hilbertOrder(const std::vector<Point>& points) {
+    std::vector<std::size_t> order(points.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    if (points.size() < 2) return order;
+
+    sortByHilbert(points, makeGrid(points), order.begin(), order.end());
+    return order;
+}
+
+std::vector<std::size_t> brioOrder(const std::vector<Point>& points, unsigned seed) {
+    std::vector<std::size_t> order(points.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    if (points.size() < 2) return order;
+
+    // Номер раунда: сколько раз подряд выпал "орел"; чем больше номер, тем раньше раунд
+    std::mt19937 rng(seed);
+    std::vector<int> round(points.size());
+    for (auto& r : round) {
+        std::uint32_t bits = rng();
+        r = 0;
+        while ((bits & 1u) && r < 31) {
+            ++r;
+            bits >>= 1;
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return round[a] > round[b];
+    });
+
+    const Grid g = makeGrid(points);
+    auto first = order.begin();
+    while (first != order.end()) {
+        int r = round[*first];
+        auto last = std::find_if(first, order.end(), [&](std::size_t i) { return round[i] != r; });
+        sortByHilbert(points, g, first, last);
+        first = last;
+    }
+    return order;
+}
@@ -0,0 +1,537 @@
+#include "core/Triangulation.h"
+#include "core/SpatialSort.h"
+#include "core/Predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;   // 2^-53
+
+int sign(double v) { return (v > 0) - (v < 0); }
+int compare(double a, double b) { return (a > b) - (a < b); }
+
+// Знак orient2d(a, b, s_k) для настоящих a и b: старший ненулевой
+// коэффициент многочлена от M. Ноль - только при a == b
+int superOrient(const Point& a, const Point& b, int k) {
+    switch (k) {
+    case 0:  return a.y != b.y ? compare(b.y, a.y) : compare(a.x, b.x);
+    case 1:  return a.y != b.y ? compare(a.y, b.y) : compare(a.x, b.x);
+    default: return a.x != b.x ? compare(b.x, a.x) : compare(a.y, b.y);
+    }
+}
+
+// Для a, b, s_k против часовой: предел описанной окружности - полуплоскость
+// слева от ab; точка на прямой ab внутри, только если она строго между a и b
+bool inSuperCircle1(const Point& a, const Point& b, const Point& p) {
+    int side = sign(orient2d(a, b, p));
+    if (side != 0) return side > 0;
+    if (a.x != b.x) return std::min(a.x, b.x) < p.x && p.x < std::max(a.x, b.x);
+    return std::min(a.y, b.y) < p.y && p.y < std::max(a.y, b.y);
+}
+
+// Треугольник a, s_k, s_(k+1): окружность вырождается в полуплоскость,
+// ограниченную горизонталью через a (точки на ней различает x)
+bool inSuperCircle2(const Point& a, int k, const Point& p) {
+    switch (k) {
+    case 0:  return p.y != a.y ? p.y < a.y : p.x > a.x;
+    case 1:  return p.y != a.y ? p.y > a.y : p.x > a.x;
+    default: return p.y != a.y ? p.y > a.y : p.x < a.x;
+    }
+}
+
+} // namespace
+
+Triangulation::Triangulation() {
+    constexpr double Symbolic = std::numeric_limits<double>::quiet_NaN();
+    m_vertices.assign(SuperVertices, Point{Symbolic, Symbolic});
+    m_vertexFace.assign(SuperVertices, None);
+    m_lastFace = newFace(0, 1, 2);
+}
+
+Triangulation Triangulation::build(const std::vector<Point>& points, std::vector<int>* ids) {
+    if (ids) ids->assign(points.size(), None);
+
+    // Порядок BRIO держит прогулку от предыдущей вставки короткой
+    Triangulation triangulation;
+    triangulation.reserve(points.size());
+    for (std::size_t i : brioOrder(points)) {
+        int id = triangulation.insert(points[i]);
+        if (ids) (*ids)[i] = id;
+    }
+    return triangulation;
+}
+
+void Triangulation::reserve(std::size_t points) {
+    m_vertices.reserve(points + SuperVertices);
+    m_vertexFace.reserve(points + SuperVertices);
+    m_faces.reserve(2*points + 1);
+    m_stamp.reserve(2*points + 1);
+    m_circles.reserve(2*points + 1);
+}
+
+int Triangulation::newFace(int a, int b, int c) {
+    int f;
+    if (!m_freeFaces.empty()) {
+        f = m_freeFaces.back();
+        m_freeFaces.pop_back();
+    } else {
+        f = (int)m_faces.size();
+        m_faces.emplace_back();
+        m_stamp.push_back(0);
+        m_circles.emplace_back();
+    }
+    m_faces[f] = Face{{a, b, c}, {None, None, None}, true};
+    updateCircle(f);
+    m_vertexFace[a] = m_vertexFace[b] = m_vertexFace[c] = f;
+    return f;
+}
+
+void Triangulation::freeFace(int face) {
+    m_faces[face].alive = false;
+    m_freeFaces.push_back(face);
+}
+
+void Triangulation::updateCircle(int face) {
+    const Face& f = m_faces[face];
+    // У треугольников с символической вершиной окружность не хранится
+    if (f.v[0] < SuperVertices || f.v[1] < SuperVertices || f.v[2] < SuperVertices) return;
+    const Point& a = m_vertices[f.v[0]];
+    const Point& b = m_vertices[f.v[1]];
+    const Point& c = m_vertices[f.v[2]];
+
+    // Центр считается относительно a, так меньше потеря точности
+    double bx = b.x - a.x, by = b.y - a.y;
+    double cx = c.x - a.x, cy = c.y - a.y;
+    double d  = 2*(bx*cy - by*cx);
+    double b2 = bx*bx + by*by;
+    double c2 = cx*cx + cy*cy;
+
+    Circle& circle = m_circles[face];
+    if (d == 0) {
+        // Вырожденный треугольник: всегда точная проверка
+        circle = {a, 0, std::numeric_limits<double>::infinity()};
+        return;
+    }
+
+    double ux = (cy*b2 - by*c2) / d;
+    double uy = (bx*c2 - cx*b2) / d;
+    circle.center = {a.x + ux, a.y + uy};
+    // Радиус - до записанного центра: оценка ниже сравнивает расстояния от него
+    double rx = a.x - circle.center.x, ry = a.y - circle.center.y;
+    circle.radius2 = rx*rx + ry*ry;
+
+    // delta - граница расстояния от записанного центра до точного (первый
+    // порядок по Epsilon = u, запас 1%). При R = |u|, |b||c| <= (b2 + c2) / 2:
+    // округление разностей b - a, c - a сдвигает точный центр на 12uR|b||c| / |d|
+    // по каждой оси, формулы центра добавляют 20uR|b||c| / |d| + uR, перенос
+    // обратно к a - u на модуль координаты
+    double radius = std::sqrt(ux*ux + uy*uy);
+    double delta = 1.01 * Epsilon * (std::sqrt(2.0) * radius * (16 * (b2 + c2) / std::abs(d) + 1) +
+                                     std::abs(circle.center.x) + std::abs(circle.center.y));
+
+    // Если расстояния от записанного центра до точки и до a расходятся больше
+    // чем на 2 delta, точные расходятся в ту же сторону. В квадратах это
+    // 4 delta r + 4 delta^2, плюс по 4u на округление квадратов расстояний и u
+    // на вычитание в сравнении. Переполнение дает inf или NaN - и точную проверку
+    double r = std::sqrt(circle.radius2);
+    circle.tolerance = 1.01 * (4*delta*r + 4*delta*delta + 10*Epsilon*circle.radius2);
+}
+
+int Triangulation::orientSign(int a, int b, const Point& p) const {
+    const bool superA = a < SuperVertices, superB = b < SuperVertices;
+    if (!superA && !superB) return sign(orient2d(m_vertices[a], m_vertices[b], p));
+    // Ребро супер-треугольника: все настоящие точки слева от s_k -> s_(k+1)
+    if (superA && superB) return b == (a + 1) % SuperVertices ? 1 : -1;
+    // Одна символическая вершина: циклическим сдвигом ставим ее последней
+    if (superA) return superOrient(m_vertices[b], p, a);
+    return superOrient(p, m_vertices[a], b);
+}
+
+int Triangulation::orientSign(int a, int b, int c) const {
+    if (c >= SuperVertices) return orientSign(a, b, m_vertices[c]);
+    if (a >= SuperVertices) return orientSign(b, c, m_vertices[a]);
+    if (b >= SuperVertices) return orientSign(c, a, m_vertices[b]);
+    // Три символические вершины: знак перестановки (0, 1, 2)
+    return b == (a + 1) % SuperVertices ? 1 : -1;
+}
+
+bool Triangulation::inCircumCircle(int face, const Point& p) const {
+    const Face& f = m_faces[face];
+    const int supers = (f.v[0] < SuperVertices) + (f.v[1] < SuperVertices) + (f.v[2] < SuperVertices);
+    if (supers == 3) return true;
+    if (supers == 2) {
+        int k = f.v[0] >= SuperVertices ? 0 : f.v[1] >= SuperVertices ? 1 : 2;
+        return inSuperCircle2(m_vertices[f.v[k]], f.v[(k + 1) % 3], p);
+    }
+    if (supers == 1) {
+        int k = f.v[0] < SuperVertices ? 0 : f.v[1] < SuperVertices ? 1 : 2;
+        return inSuperCircle1(m_vertices[f.v[(k + 1) % 3]], m_vertices[f.v[(k + 2) % 3]], p);
+    }
+
+    const Circle& circle = m_circles[face];
+    double dx = p.x - circle.center.x;
+    double dy = p.y - circle.center.y;
+    double d2 = dx*dx + dy*dy;
+    if (d2 < circle.radius2 - circle.tolerance) return true;
+    if (d2 > circle.radius2 + circle.tolerance) return false;
+
+    return incircle(m_vertices[f.v[0]], m_vertices[f.v[1]], m_vertices[f.v[2]], p) > 0;
+}
+
+int Triangulation::locate(const Point& p) const {
+    if (m_faces.empty()) return None;
+
+    int t = m_lastFace;
+    if (t == None || !m_faces[t].alive) {
+        t = None;
+        for (int i = 0; i < (int)m_faces.size() && t == None; ++i)
+            if (m_faces[i].alive) t = i;
+    }
+
+    // Прогулка по соседям: переходим через ребро, за которым лежит точка.
+    // Начальное ребро сдвигается на каждом шаге, чтобы не зациклиться.
+    const std::size_t maxSteps = m_faces.size() + 3;
+    for (std::size_t step = 0; step < maxSteps; ++step) {
+        const Face& f = m_faces[t];
+        int next = t;
+        for (int k = 0; k < 3; ++k) {
+            int i = (int)((k + step) % 3);
+            if (orientSign(f.v[(i + 1) % 3], f.v[(i + 2) % 3], p) < 0) {
+                next = f.n[i];
+                break;
+            }
+        }
+        if (next == t) return t;
+        if (next == None) return None;  // не конечная точка
+        t = next;
+    }
+
+    // Вырожденный случай: прогулка не сошлась, ищем перебором
+    for (int i = 0; i < (int)m_faces.size(); ++i) {
+        const Face& f = m_faces[i];
+        if (!f.alive) continue;
+        if (orientSign(f.v[0], f.v[1], p) >= 0 &&
+            orientSign(f.v[1], f.v[2], p) >= 0 &&
+            orientSign(f.v[2], f.v[0], p) >= 0)
+            return i;
+    }
+    return None;
+}
+
+int Triangulation::insert(const Point& p) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) return None;
+    int start = locate(p);
+    if (start == None) return None;
+
+    // Совпадение с существующей вершиной - точку не добавляем
+    for (int v : m_faces[start].v) {
+        if (m_vertices[v] == p) return v - SuperVertices;
+    }
+
+    m_vertices.push_back(p);
+    m_vertexFace.push_back(None);
+    insertVertex((int)m_vertices.size() - 1, start);
+    return (int)m_vertices.size() - 1 - SuperVertices;
+}
+
+void Triangulation::insertVertex(int pv, int start) {
+    const Point& p = m_vertices[pv];
+
+    // Находим "плохие" треугольники обходом от содержащего точку
+    ++m_currentStamp;
+    m_cavity.clear();
+    m_stack.clear();
+    m_stack.push_back(start);
+    m_stamp[start] = m_currentStamp;
+    while (!m_stack.empty()) {
+        int t = m_stack.back();
+        m_stack.pop_back();
+        m_cavity.push_back(t);
+        for (int nb : m_faces[t].n) {
+            if (nb == None || m_stamp[nb] == m_currentStamp) continue;
+            if (inCircumCircle(nb, p)) {
+                m_stamp[nb] = m_currentStamp;
+                m_stack.push_back(nb);
+            }
+        }
+    }
+
+    // Граница полости - ребра, за которыми нет "плохого" соседа
+    m_boundary.clear();
+    for (int t : m_cavity) {
+        const Face& f = m_faces[t];
+        for (int i = 0; i < 3; ++i) {
+            int nb = f.n[i];
+            if (nb != None && m_stamp[nb] == m_currentStamp) continue;
+            int slot = -1;
+            if (nb != None) {
+                const Face& o = m_faces[nb];
+                slot = (o.n[0] == t) ? 0 : (o.n[1] == t) ? 1 : 2;
+            }
+            m_boundary.push_back({f.v[(i + 1) % 3], f.v[(i + 2) % 3], nb, slot});
+        }
+    }
+
+    // Удаляем плохие треугольники
+    for (int t : m_cavity) freeFace(t);
+
+    // Добавляем новые треугольники (a, b, p) и сшиваем их с внешними соседями
+    m_faceByStart.clear();
+    for (const BoundaryEdge& e : m_boundary) {
+        int f = newFace(e.a, e.b, pv);
+        m_faces[f].n[2] = e.outer;
+        if (e.outer != None) m_faces[e.outer].n[e.outerSlot] = f;
+        m_faceByStart[e.a] = f;
+    }
+
+    // Новые треугольники образуют веер вокруг p: соседи находятся по вершинам границы
+    for (const auto& [a, f] : m_faceByStart) {
+        Face& face = m_faces[f];
+        int b = face.v[1];
+        int next = m_faceByStart[b];   // треугольник (b, c, p)
+        face.n[0] = next;              // ребро (b, p)
+        m_faces[next].n[1] = f;        // у соседа это ребро (p, b)
+    }
+
+    m_lastFace = m_faceByStart.begin()->second;
+}
+
+std::vector<Triangle> Triangulation::triangles() const {
+    std::vector<Triangle> result;
+    result.reserve(m_faces.size());
+    forEachTriangle([&](const Point& a, const Point& b, const Point& c) {
+        result.push_back({a, b, c});
+    });
+    return result;
+}
+
+DelaunayMesh Triangulation::toMesh() const {
+    DelaunayMesh mesh;
+    mesh.vertices.assign(m_vertices.begin() + SuperVertices, m_vertices.end());
+
+    // Нумеруем оставшиеся треугольники подряд
+    std::vector<int> index(m_faces.size(), None);
+    int count = 0;
+    for (std::size_t i = 0; i < m_faces.size(); ++i) {
+        const Face& f = m_faces[i];
+        if (!f.alive) continue;
+        if (f.v[0] < SuperVertices || f.v[1] < SuperVertices || f.v[2] < SuperVertices)
+            continue;
+        index[i] = count++;
+    }
+
+    mesh.triangles.reserve(count);
+    mesh.neighbors.reserve(count);
+    for (std::size_t i = 0; i < m_faces.size(); ++i) {
+        if (index[i] == None) continue;
+        const Face& f = m_faces[i];
+        mesh.triangles.push_back({f.v[0] - SuperVertices, f.v[1] - SuperVertices, f.v[2] - SuperVertices});
+        mesh.neighbors.push_back({f.n[0] == None ? None : index[f.n[0]],
+                                  f.n[1] == None ? None : index[f.n[1]],
+                                  f.n[2] == None ? None : index[f.n[2]]});
+    }
+    return mesh;
+}
+
+int Triangulation::slotOf(int face, int vertex) const {
+    const Face& f = m_faces[face];
+    return (f.v[0] == vertex) ? 0 : (f.v[1] == vertex) ? 1 : 2;
+}
+
+void Triangulation::replaceNeighbor(int face, int from, int to) {
+    if (face == None) return;
+    for (int& nb : m_faces[face].n) {
+        if (nb == from) {
+            nb = to;
+            return;
+        }
+    }
+}
+
+// Флип ребра напротив f.v[slot]: треугольники (p, a, b) и (q, b, a)
+// превращаются в (p, a, q) и (q, b, p)
+void Triangulation::flip(int f, int slot) {
+    Face& F = m_faces[f];
+    const int g = F.n[slot];
+    Face& G = m_faces[g];
+    const int j = (G.n[0] == f) ? 0 : (G.n[1] == f) ? 1 : 2;
+
+    const int p = F.v[slot];
+    const int a = F.v[(slot + 1) % 3];
+    const int b = F.v[(slot + 2) % 3];
+    const int q = G.v[j];
+
+    const int fa = F.n[(slot + 1) % 3];   // ребро (b, p)
+    const int fb = F.n[(slot + 2) % 3];   // ребро (p, a)
+    const int ga = G.n[(j + 2) % 3];      // ребро (q, b)
+    const int gb = G.n[(j + 1) % 3];      // ребро (a, q)
+
+    F = Face{{p, a, q}, {gb, g, fb}, true};
+    G = Face{{q, b, p}, {fa, f, ga}, true};
+    updateCircle(f);
+    updateCircle(g);
+    replaceNeighbor(gb, g, f);
+    replaceNeighbor(fa, f, g);
+
+    m_vertexFace[p] = m_vertexFace[a] = m_vertexFace[q] = f;
+    m_vertexFace[b] = g;
+}
+
+void Triangulation::legalize() {
+    // С точными предикатами флипы Лоусона конечны; бюджет - страховка, и если
+    // он кончился, триангуляция собирается заново, а не остается не Делоне
+    std::size_t budget = 16 * m_faces.size() + 64;
+    while (!m_flipQueue.empty()) {
+        if (budget-- == 0) {
+            rebuild();
+            return;
+        }
+        EdgeRef e = m_flipQueue.back();
+        m_flipQueue.pop_back();
+
+        const Face& F = m_faces[e.face];
+        if (!F.alive) continue;
+        const int g = F.n[e.slot];
+        if (g == None) continue;
+        const Face& G = m_faces[g];
+        const int j = (G.n[0] == e.face) ? 0 : (G.n[1] == e.face) ? 1 : 2;
+
+        const int p = F.v[e.slot];
+        const int a = F.v[(e.slot + 1) % 3];
+        const int b = F.v[(e.slot + 2) % 3];
+        const int q = G.v[j];
+        // q в окружности (p, a, b) тогда же, когда p в окружности (q, b, a):
+        // проверяется та, у которой вершина-запрос настоящая. Если обе
+        // символические, ребро законно (или четырехугольник не выпуклый)
+        bool illegal = q >= SuperVertices ? inCircumCircle(e.face, m_vertices[q])
+                     : p >= SuperVertices ? inCircumCircle(g, m_vertices[p])
+                     : false;
+        if (!illegal) continue;
+        if (orientSign(p, a, q) <= 0 || orientSign(q, b, p) <= 0) continue;
+
+        flip(e.face, e.slot);
+        m_flipQueue.push_back({e.face, 0});
+        m_flipQueue.push_back({e.face, 2});
+        m_flipQueue.push_back({g, 0});
+        m_flipQueue.push_back({g, 2});
+    }
+    m_flipQueue.clear();
+}
+
+void Triangulation::detachVertex(int vi) {
+    m_flipQueue.clear();
+
+    // Уменьшаем степень вершины флипами до трех
+    std::vector<int>& star = m_stack;
+    for (;;) {
+        star.clear();
+        const int first = m_vertexFace[vi];
+        int f = first;
+        do {
+            star.push_back(f);
+            f = m_faces[f].n[(slotOf(f, vi) + 1) % 3];
+        } while (f != first && f != None && star.size() <= m_faces.size());
+
+        if (star.size() <= 3) break;
+
+        bool flipped = false;
+        for (int s : star) {
+            const int k = slotOf(s, vi);
+            const int a = m_faces[s].v[(k + 1) % 3];
+            const int b = m_faces[s].v[(k + 2) % 3];
+            const int g = m_faces[s].n[(k + 1) % 3];     // треугольник (vi, b, c)
+            const int c = m_faces[g].v[(slotOf(g, vi) + 2) % 3];
+            if (orientSign(a, b, c) > 0 && orientSign(c, vi, a) > 0) {
+                flip(s, (k + 1) % 3);
+                for (int i = 0; i < 3; ++i) {
+                    m_flipQueue.push_back({s, i});
+                    m_flipQueue.push_back({g, i});
+                }
+                flipped = true;
+                break;
+            }
+        }
+        if (!flipped) break;
+    }
+
+    if (star.size() != 3) {
+        // Численно вырожденная звезда: собираем триангуляцию заново без этой вершины
+        m_vertexFace[vi] = None;
+        rebuild();
+        return;
+    }
+
+    // Три треугольника вокруг вершины сливаются в один
+    const int f1 = star[0], f2 = star[1], f3 = star[2];
+    const int k1 = slotOf(f1, vi), k2 = slotOf(f2, vi), k3 = slotOf(f3, vi);
+    const int a = m_faces[f1].v[(k1 + 1) % 3];
+    const int b = m_faces[f1].v[(k1 + 2) % 3];
+    const int c = m_faces[f2].v[(k2 + 2) % 3];
+    const int outer1 = m_faces[f1].n[k1];
+    const int outer2 = m_faces[f2].n[k2];
+    const int outer3 = m_faces[f3].n[k3];
+
+    m_faces[f1] = Face{{a, b, c}, {outer2, outer3, outer1}, true};
+    updateCircle(f1);
+    replaceNeighbor(outer2, f2, f1);
+    replaceNeighbor(outer3, f3, f1);
+    freeFace(f2);
+    freeFace(f3);
+
+    m_vertexFace[a] = m_vertexFace[b] = m_vertexFace[c] = f1;
+    m_vertexFace[vi] = None;
+    m_lastFace = f1;
+
+    for (int i = 0; i < 3; ++i) m_flipQueue.push_back({f1, i});
+    legalize();
+}
+
+void Triangulation::rebuild() {
+    m_faces.clear();
+    m_stamp.clear();
+    m_circles.clear();
+    m_freeFaces.clear();
+    m_flipQueue.clear();
+
+    std::vector<int> vertices;
+    for (int v = SuperVertices; v < (int)m_vertices.size(); ++v) {
+        if (m_vertexFace[v] != None) vertices.push_back(v);
+    }
+    m_lastFace = newFace(0, 1, 2);
+    for (int v : vertices) m_vertexFace[v] = None;
+
+    for (int v : vertices) {
+        int start = locate(m_vertices[v]);
+        if (start == None) continue;
+        bool duplicate = false;
+        for (int w : m_faces[start].v) duplicate = duplicate || m_vertices[w] == m_vertices[v];
+        if (!duplicate) insertVertex(v, start);
+    }
+}
+
+bool Triangulation::remove(int v) {
+    const int vi = v + SuperVertices;
+    if (m_vertexFace[vi] == None) return false;
+    detachVertex(vi);
+    return true;
+}
+
+bool Triangulation::move(int v, const Point& p) {
+    const int vi = v + SuperVertices;
+    if (m_vertexFace[vi] != None) {
+        if (m_vertices[vi] == p) return true;
+        detachVertex(vi);
+    }
+    m_vertices[vi] = p;
+
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) return false;
+    int start = locate(p);
+    if (start == None) return false;
+    for (int w : m_faces[start].v) {
+        if (m_vertices[w] == p) return false;
+    }
+    insertVertex(vi, start);
+    return true;
+}
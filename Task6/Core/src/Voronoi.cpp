@@ -0,0 +1,83 @@
+#include "core/Voronoi.h"
+
+namespace {
+
+Point circumCenter(const Point& a, const Point& b, const Point& c) {
+    // Считаем относительно a, чтобы не терять точность на больших координатах
+    double bx = b.x - a.x, by = b.y - a.y;
+    double cx = c.x - a.x, cy = c.y - a.y;
+    double d = 2 * (bx*cy - by*cx);
+    if (d == 0) {
+        return {(a.x + b.x + c.x)/3, (a.y + b.y + c.y)/3};
+    }
+    double b2 = bx*bx + by*by;
+    double c2 = cx*cx + cy*cy;
+    return {a.x + (cy*b2 - by*c2) / d, a.y + (bx*c2 - cx*b2) / d};
+}
+
+} // namespace
+
+VoronoiDiagram voronoiDiagram(const DelaunayMesh& mesh) {
+    VoronoiDiagram diagram;
+    const int triangleCount = (int)mesh.triangles.size();
+    const int siteCount = (int)mesh.vertices.size();
+
+    // Центр описанной окружности считается один раз на треугольник
+    diagram.vertices.reserve(triangleCount);
+    for (const auto& t : mesh.triangles) {
+        diagram.vertices.push_back(circumCenter(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]));
+    }
+
+    // Ребра: внутренние ребра сетки дают отрезки, граничные - лучи наружу
+    diagram.edges.reserve(3 * triangleCount / 2 + 3);
+    std::vector<int> siteTriangle(siteCount, -1);
+    for (int t = 0; t < triangleCount; ++t) {
+        for (int i = 0; i < 3; ++i) {
+            siteTriangle[mesh.triangles[t][i]] = t;
+
+            int nb = mesh.neighbors[t][i];
+            if (nb > t) {
+                diagram.edges.push_back({t, nb, {0, 0}});
+            } else if (nb < 0) {
+                const Point& a = mesh.vertices[mesh.triangles[t][(i + 1) % 3]];
+                const Point& b = mesh.vertices[mesh.triangles[t][(i + 2) % 3]];
+                diagram.edges.push_back({t, -1, {b.y - a.y, a.x - b.x}});
+            }
+        }
+    }
+
+    // Ячейки: обход треугольников вокруг сайта по соседям
+    auto slotOf = [&](int t, int v) {
+        const auto& tri = mesh.triangles[t];
+        return tri[0] == v ? 0 : tri[1] == v ? 1 : 2;
+    };
+
+    diagram.cellOffsets.reserve(siteCount + 1);
+    diagram.cellVertices.reserve(3 * triangleCount);
+    diagram.cellClosed.assign(siteCount, 0);
+    diagram.cellOffsets.push_back(0);
+    for (int v = 0; v < siteCount; ++v) {
+        int start = siteTriangle[v];
+        if (start >= 0) {
+            // Отходим по часовой стрелке до границы (или до замыкания)
+            int t = start;
+            bool closed = false;
+            for (;;) {
+                int prev = mesh.neighbors[t][(slotOf(t, v) + 2) % 3];
+                if (prev < 0) break;
+                if (prev == start) { closed = true; break; }
+                t = prev;
+            }
+
+            // И собираем ячейку против часовой стрелки
+            const int first = t;
+            do {
+                diagram.cellVertices.push_back(t);
+                t = mesh.neighbors[t][(slotOf(t, v) + 1) % 3];
+            } while (t >= 0 && t != first);
+            diagram.cellClosed[v] = closed;
+        }
+        diagram.cellOffsets.push_back((int)diagram.cellVertices.size());
+    }
+    return diagram;
+}
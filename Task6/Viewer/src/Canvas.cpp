@@ -5,9 +5,6 @@
 #include <vector>
 #include <algorithm>
 
-// Объявление внешней функции
-std::vector<Triangle> delaunayTriangulation(const std::vector<Point>& points);
-
 DrawingWidget::DrawingWidget(QWidget *parent) : QWidget(parent), draggingIndex(-1) {
     setMouseTracking(true);
 }
@@ -20,10 +17,30 @@ void DrawingWidget::paintEvent(QPaintEvent*) {
     painter.setPen(QPen(Qt::blue, 1));
     painter.setBrush(Qt::NoBrush);
 
-    for (const auto &t : triangles) {
-        painter.drawLine(QPointF(t.a.x, t.a.y), QPointF(t.b.x, t.b.y));
-        painter.drawLine(QPointF(t.b.x, t.b.y), QPointF(t.c.x, t.c.y));
-        painter.drawLine(QPointF(t.c.x, t.c.y), QPointF(t.a.x, t.a.y));
+    if (hasTriangulation) {
+        triangulation.forEachTriangle([&](const Point& a, const Point& b, const Point& c) {
+            painter.drawLine(QPointF(a.x, a.y), QPointF(b.x, b.y));
+            painter.drawLine(QPointF(b.x, b.y), QPointF(c.x, c.y));
+            painter.drawLine(QPointF(c.x, c.y), QPointF(a.x, a.y));
+        });
+    }
+
+    // Диаграмма Вороного рисуется прямо по триангуляции: центры окружностей
+    // в ней уже посчитаны, так что перенос точки ничего не перестраивает
+    if (showVoronoi && hasTriangulation) {
+        painter.setPen(QPen(Qt::darkMagenta, 1));
+        const double rayLength = width() + height();
+        triangulation.forEachVoronoiEdge(
+            [&](const Point& a, const Point& b) {
+                painter.drawLine(QPointF(a.x, a.y), QPointF(b.x, b.y));
+            },
+            [&](const Point& a, const Point& direction) {
+                double len = std::hypot(direction.x, direction.y);
+                if (len == 0) return;
+                painter.drawLine(QPointF(a.x, a.y),
+                                 QPointF(a.x + direction.x / len * rayLength,
+                                         a.y + direction.y / len * rayLength));
+            });
     }
 
     // Рисуем точки
@@ -35,7 +52,7 @@ void DrawingWidget::paintEvent(QPaintEvent*) {
     }
 
     // Выделяем перетаскиваемую точку
-    if (draggingIndex >= 0 && draggingIndex < points.size()) {
+    if (draggingIndex >= 0 && draggingIndex < (int)points.size()) {
         painter.setBrush(Qt::green);
         painter.drawEllipse(QPointF(points[draggingIndex].x, points[draggingIndex].y), 7, 7);
     }
@@ -46,7 +63,7 @@ void DrawingWidget::mousePressEvent(QMouseEvent* event) {
     draggingIndex = -1;
 
     // Проверяем, кликнули ли на существующую точку
-    for (int i = 0; i < points.size(); ++i) {
+    for (int i = 0; i < (int)points.size(); ++i) {
         double dx = points[i].x - pos.x();
         double dy = points[i].y - pos.y();
         if (dx*dx + dy*dy < 64.0) { // 8 пикселей в радиусе
@@ -58,18 +75,32 @@ void DrawingWidget::mousePressEvent(QMouseEvent* event) {
     // Если не кликнули на точку, добавляем новую
     if (draggingIndex == -1) {
         if (event->button() == Qt::LeftButton) {
-            points.append(Point(pos));
-            if (autoUpdate) rebuildTriangulation();
+            points.push_back(Point{pos.x(), pos.y()});
+            if (autoUpdate) insertIntoTriangulation((int)points.size() - 1);
             update();
         }
     }
 }
 
 void DrawingWidget::mouseMoveEvent(QMouseEvent* event) {
-    if (draggingIndex != -1 && draggingIndex < points.size()) {
+    if (draggingIndex != -1 && draggingIndex < (int)points.size()) {
         QPointF pos = event->position();
-        points[draggingIndex] = Point(pos);
-        if (autoUpdate) rebuildTriangulation();
+        points[draggingIndex] = Point{pos.x(), pos.y()};
+        if (autoUpdate) {
+            // Переносим одну вершину локальными флипами вместо полной перестройки;
+            // целиком перестраиваем, только если триангуляция отстала от точек
+            if (!hasTriangulation || vertexIds.size() != points.size()) {
+                rebuildTriangulation();
+            } else if (int &id = vertexIds[draggingIndex]; id != Triangulation::None) {
+                // false - точка легла на другую: вершина ждет следующего переноса
+                triangulation.move(id, points[draggingIndex]);
+            } else {
+                // Точка совпадала с другой и своей вершины не имела
+                std::size_t before = triangulation.vertexCount();
+                int inserted = triangulation.insert(points[draggingIndex]);
+                if (triangulation.vertexCount() > before) id = inserted;
+            }
+        }
         update();
     }
 }
@@ -82,35 +113,39 @@ void DrawingWidget::mouseReleaseEvent(QMouseEvent* event) {
 }
 
 void DrawingWidget::rebuildTriangulation() {
-    if (points.size() < 3) {
-        triangles.clear();
-        update();
-        return;
-    }
-
-    // Конвертируем в std::vector
-    std::vector<Point> stdPoints;
-    stdPoints.reserve(points.size());
-    for (const auto &p : points) {
-        stdPoints.push_back(p);
+    triangulation = Triangulation::build(points, &vertexIds);
+    hasTriangulation = true;
+
+    // Совпадающие точки делят одну вершину; перетаскивать ее будет только первая
+    std::vector<bool> used(triangulation.vertexCount(), false);
+    for (int &id : vertexIds) {
+        if (id == Triangulation::None) continue;
+        if (used[id]) id = Triangulation::None;
+        else used[id] = true;
     }
 
-    // Вызываем алгоритм триангуляции
-    std::vector<Triangle> temp = delaunayTriangulation(stdPoints);
+    update();
+}
 
-    // Конвертируем обратно в QVector
-    triangles.clear();
-    triangles.reserve(static_cast<int>(temp.size()));
-    for (const auto &t : temp) {
-        triangles.append(Triangle(t));
+void DrawingWidget::insertIntoTriangulation(int index) {
+    // Точки, добавленные без Auto-update, в триангуляцию еще не попали
+    if (!hasTriangulation || vertexIds.size() != points.size() - 1) {
+        rebuildTriangulation();
+        return;
     }
 
-    update();
+    // Супер-треугольник символический, так что вставка удается для любой
+    // конечной точки; совпавшая с другой точка своей вершины не получает
+    std::size_t before = triangulation.vertexCount();
+    int id = triangulation.insert(points[index]);
+    vertexIds.push_back(triangulation.vertexCount() > before ? id : Triangulation::None);
 }
 
 void DrawingWidget::clearPoints() {  // ЭТА ФУНКЦИЯ ДОЛЖНА БЫТЬ!
     points.clear();
-    triangles.clear();
+    vertexIds.clear();
+    triangulation = Triangulation();
+    hasTriangulation = false;
     draggingIndex = -1;
     update();
 }
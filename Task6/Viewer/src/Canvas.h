@@ -1,40 +1,8 @@
 #pragma once
 #include <QWidget>
-#include <QVector>
 #include <QPointF>
-
-struct Point {
-    double x, y;
-
-    // Конструкторы
-    Point() : x(0), y(0) {}
-    Point(double x_, double y_) : x(x_), y(y_) {}
-    Point(const QPointF& qpoint) : x(qpoint.x()), y(qpoint.y()) {}
-
-    // Явно указываем, что хотим использовать сгенерированные методы
-    Point(const Point&) = default;
-    Point& operator=(const Point&) = default;
-
-    bool operator==(const Point& other) const {
-        return std::abs(x - other.x) < 1e-6 && std::abs(y - other.y) < 1e-6;
-    }
-};
-
-struct Triangle {
-    Point a, b, c;
-
-    // Конструкторы
-    Triangle() : a(), b(), c() {}
-    Triangle(Point a_, Point b_, Point c_) : a(a_), b(b_), c(c_) {}
-
-    // Явно указываем, что хотим использовать сгенерированные методы
-    Triangle(const Triangle&) = default;
-    Triangle& operator=(const Triangle&) = default;
-
-    bool operator==(const Triangle& other) const {
-        return (a == other.a && b == other.b && c == other.c);
-    }
-};
+#include <vector>
+#include "core/Triangulation.h"
 
 class DrawingWidget : public QWidget {
     Q_OBJECT
@@ -49,6 +17,7 @@ public:
     void rebuildTriangulation();
     void clearPoints(); // Должен быть объявлен
     bool autoUpdate = false;
+    bool showVoronoi = false;
 
 protected:
     void paintEvent(QPaintEvent* event) override;
@@ -57,7 +26,11 @@ protected:
     void mouseReleaseEvent(QMouseEvent* event) override;
 
 private:
-    QVector<Point> points;
-    QVector<Triangle> triangles;
+    std::vector<Point> points;
+    std::vector<int> vertexIds;        // индекс вершины в triangulation для каждой точки
+    Triangulation triangulation;       // хранится между правками для режима Auto-update
+    bool hasTriangulation = false;
     int draggingIndex;
+
+    void insertIntoTriangulation(int index);
 };
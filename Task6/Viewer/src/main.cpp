@@ -25,6 +25,9 @@ int main(int argc, char *argv[]) {
 
     QCheckBox* autoCheck = new QCheckBox("Auto-update");
     buttonLayout->addWidget(autoCheck);
+
+    QCheckBox* voronoiCheck = new QCheckBox("Voronoi");
+    buttonLayout->addWidget(voronoiCheck);
     buttonLayout->addStretch();
 
     mainLayout->addLayout(buttonLayout);
@@ -37,6 +40,11 @@ int main(int argc, char *argv[]) {
         drawing->autoUpdate = checked;
     });
 
+    QObject::connect(voronoiCheck, &QCheckBox::toggled, [=](bool checked) {
+        drawing->showVoronoi = checked;
+        drawing->update();
+    });
+
     window.resize(800, 600);
     window.show();
 
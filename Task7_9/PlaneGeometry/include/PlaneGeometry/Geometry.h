@@ -16,17 +16,72 @@ inline double cross(const Point& a, const Point& b) { return a.x*b.y - a.y*b.x;
 inline double cross(const Point& o, const Point& a, const Point& b) { return cross(a-o, b-o); }
 inline double dot(const Point& a, const Point& b) { return a.x*b.x + a.y*b.y; }
 
+enum class HullAlgorithm {
+    MonotoneChain,   // Эндрю, O(n log n); сортировка раскладкой по корзинам (sortByXY)
+    Chan,            // Чан, O(n log h); на замеренных наборах медленнее цепочки
+};
+
+// Этапы построения выпуклой оболочки
+struct HullOptions {
+    bool cullInterior = true;   // отсечение Акла-Туссена перед сортировкой
+    HullAlgorithm algorithm = HullAlgorithm::MonotoneChain;
+    unsigned threads = 1;       // 0 - по числу ядер
+};
+
+// Счетчики одного построения оболочки
+struct HullStats {
+    size_t input = 0;    // точек на входе
+    size_t culled = 0;   // отброшено отсечением
+    HullAlgorithm algorithm = HullAlgorithm::MonotoneChain;   // Chan - если им построена хотя бы одна часть
+};
+
 Polygon convexHull(const std::vector<Point>& pts);
+Polygon convexHull(const std::vector<Point>& pts, const HullOptions& options, HullStats* stats = nullptr);
+
+// Отсечение Акла-Туссена: удаляет из pts точки, строго лежащие внутри
+// восьмиугольника из крайних точек по x, y, x+y и x-y (они не могут быть
+// вершинами оболочки). Порядок оставшихся точек сохраняется. Возвращает
+// число удаленных точек
+size_t cullInteriorPoints(std::vector<Point>& pts);
+
+// То же, что convexHull, но куски входа обрабатываются в threads потоках
+// (0 - по числу ядер); результат не зависит от числа потоков
+Polygon convexHullParallel(const std::vector<Point>& pts, unsigned threads = 0);
+
+// Полуплоскость слева (keepLeft) или справа от направленной прямой A -> B
+struct HalfPlane {
+    Point A, B;
+    bool keepLeft = true;
+};
 
 Polygon clipHalfPlane(const Polygon& subject, const Point& A, const Point& B, bool keepLeft);
+// То же в готовый многоугольник (его память переиспользуется); output не должен быть subject.
+// Цепочку отсечений без выделений памяти делает ClipPipeline (PlaneGeometry/ClipPipeline.h)
+void clipHalfPlane(const Polygon& subject, const HalfPlane& plane, Polygon& output);
 
 Polygon intersectConvex(const Polygon& A, const Polygon& B);
 
-
+// Часть A, лежащая справа от всех ребер выпуклого B против часовой. У B с
+// площадью таких точек нет, и результат пуст; разность A - B дает
+// differenceConvexDecomposed
 Polygon differenceConvex(const Polygon& A, const Polygon& B);
 
+// A - B для выпуклых A и B (B против часовой) как набор непересекающихся
+// выпуклых частей; части нулевой площади отбрасываются
+std::vector<Polygon> differenceConvexDecomposed(const Polygon& A, const Polygon& B);
+
+// Части A - B и сам B
 std::vector<Polygon> unionConvexDecomposed(const Polygon& A, const Polygon& B);
 
 bool pointInConvex(const Polygon& poly, const Point& p);
 
+// Запросы к выпуклым многоугольникам против часовой без построения их
+// пересечения: O(n + m), без выделений памяти. Отрезки и точки (меньше трех
+// вершин) допускаются.
+// Есть ли у A и B общая точка (касание считается). Ответ точный; проверка
+// заканчивается на первой найденной разделяющей оси
+bool convexOverlap(const Polygon& A, const Polygon& B);
+// Расстояние между A и B; 0, если они пересекаются, бесконечность - если один пуст
+double convexDistance(const Polygon& A, const Polygon& B);
+
 }
@@ -0,0 +1,87 @@
+#pragma once
+#include "PlaneGeometry/Geometry.h"
+#include <new>
+
+namespace PlaneGeometry {
+
+// Аллокатор с выравниванием под векторные регистры (AVX - 32 байта)
+template <class T, size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Набор точек в виде структуры массивов: x и y лежат в отдельных выровненных
+// массивах, и пакетный orient2d ниже обрабатывает по 4 точки за инструкцию
+class PointSet {
+public:
+    PointSet() = default;
+    explicit PointSet(const std::vector<Point>& pts) { assign(pts); }
+
+    void assign(const std::vector<Point>& pts) {
+        m_x.resize(pts.size());
+        m_y.resize(pts.size());
+        for (size_t i = 0; i < pts.size(); ++i) {
+            m_x[i] = pts[i].x;
+            m_y[i] = pts[i].y;
+        }
+    }
+
+    void push_back(const Point& p) {
+        m_x.push_back(p.x);
+        m_y.push_back(p.y);
+    }
+
+    void reserve(size_t n) { m_x.reserve(n); m_y.reserve(n); }
+    void resize(size_t n)  { m_x.resize(n); m_y.resize(n); }
+    void clear()           { m_x.clear(); m_y.clear(); }
+
+    size_t size() const { return m_x.size(); }
+    bool empty() const  { return m_x.empty(); }
+
+    Point point(size_t i) const { return {m_x[i], m_y[i]}; }
+    void set(size_t i, const Point& p) { m_x[i] = p.x; m_y[i] = p.y; }
+
+    const double* xs() const { return m_x.data(); }
+    const double* ys() const { return m_y.data(); }
+    double* xs() { return m_x.data(); }
+    double* ys() { return m_y.data(); }
+
+    std::vector<Point> toPoints() const {
+        std::vector<Point> pts(size());
+        for (size_t i = 0; i < pts.size(); ++i) pts[i] = point(i);
+        return pts;
+    }
+
+private:
+    std::vector<double, AlignedAllocator<double>> m_x, m_y;
+};
+
+struct BoundingBox {
+    double minX, minY, maxX, maxY;
+};
+
+// Пакетное ядро. На x86 с AVX2 (проверяется при выполнении) обрабатывает
+// по 4 точки за инструкцию, иначе - скалярный цикл.
+
+// out[i] - приближение orient2d(a, b, pts[i]) с точным знаком: сомнительные
+// по оценке погрешности значения пересчитываются точным предикатом
+void orient2d(const Point& a, const Point& b, const PointSet& pts, double* out);
+
+}
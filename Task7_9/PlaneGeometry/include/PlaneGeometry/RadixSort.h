@@ -0,0 +1,31 @@
+#pragma once
+#include "PlaneGeometry/Geometry.h"
+#include <cstdint>
+#include <cstring>
+
+namespace PlaneGeometry {
+
+// Ключ, монотонный по значению double: у неотрицательных чисел выставляется
+// знаковый бит, у отрицательных инвертируются все биты. -0.0 и +0.0 дают
+// один ключ, как и при сравнении double
+inline std::uint64_t orderedKey(double v) {
+    v += 0.0;   // -0.0 -> +0.0
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+}
+
+// Сортировка по (x, y) в том же порядке, что и лексикографическое сравнение
+// координат; малые наборы - std::sort. Большие раскладываются по корзинам
+// значения x (серии с равным x - по y) в два прохода: второй идет внутри
+// корзины, пока она в кэше, и оставляет серии в несколько точек. Если
+// значения x не конечны или распределены слишком неравномерно, набор
+// сортируется поразрядно (LSD) по ключам x с досортировкой серий по y.
+// Результат не зависит от threads (0 - по числу ядер)
+void sortByXY(Point* first, size_t n, unsigned threads = 1);
+
+inline void sortByXY(std::vector<Point>& pts, unsigned threads = 1) {
+    sortByXY(pts.data(), pts.size(), threads);
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "PlaneGeometry/Geometry.h"
+
+namespace PlaneGeometry {
+
+// Выпуклая оболочка потока точек за один проход, без хранения всего входа.
+// Хранятся только текущая оболочка и буфер кандидатов: точка строго внутри
+// восьмиугольника Акла-Туссена текущей оболочки отбрасывается сразу, прочие
+// копятся в буфере и при его заполнении сливаются с оболочкой. Первые слияния
+// происходят раньше (порог удваивается до bufferPoints), чтобы отсев начал
+// работать с первых точек. Порог не меньше размера оболочки, поэтому память -
+// O(bufferPoints + размер оболочки)
+class StreamingHull {
+public:
+    static constexpr size_t DefaultBufferPoints = 1 << 16;
+
+    explicit StreamingHull(const HullOptions& options = {}, size_t bufferPoints = DefaultBufferPoints);
+
+    void add(const Point& p);
+    void add(const Point* pts, size_t n);
+
+    // Оболочка всех добавленных точек (в том же виде, что у convexHull);
+    // после вызова можно продолжать добавлять точки
+    const Polygon& hull();
+
+    size_t pointsSeen() const { return m_seen; }
+    size_t pointsRejected() const { return m_rejected; }   // отброшено без буфера
+
+private:
+    HullOptions        m_options;
+    size_t             m_bufferPoints;
+    size_t             m_flushAt;       // текущий порог слияния
+    std::vector<Point> m_buffer;
+    Polygon            m_hull;
+    double             m_ax[8], m_ay[8], m_dx[8], m_dy[8];   // ребра восьмиугольника
+    bool               m_octagonReady{false};
+    size_t             m_seen{0};
+    size_t             m_rejected{0};
+
+    // > 0 - точка гарантированно строго внутри восьмиугольника
+    double margin(const Point& p) const;
+    void flush();
+};
+
+}
@@ -0,0 +1,87 @@
+#include "PlaneGeometry/PointSet.h"
+#include "PlaneGeometry/Predicates.h"
+#include <cmath>
+#include <limits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PLANE_GEOMETRY_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace PlaneGeometry {
+
+namespace {
+
+// Оценка погрешности orient2d в double (по Шевчуку)
+constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;
+constexpr double CcwErrBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+
+// Скалярное ядро; оно же досчитывает хвост векторного.
+// Возвращает false, если знак хотя бы одного значения не гарантирован
+bool orientScalar(const Point& a, const Point& b, const double* xs, const double* ys,
+                  size_t begin, size_t end, double* out) {
+    bool certain = true;
+    for (size_t i = begin; i < end; ++i) {
+        double left = (a.x - xs[i]) * (b.y - ys[i]);
+        double right = (a.y - ys[i]) * (b.x - xs[i]);
+        double det = left - right;
+        out[i] = det;
+        certain &= std::fabs(det) > CcwErrBound * (std::fabs(left) + std::fabs(right));
+    }
+    return certain;
+}
+
+#ifdef PLANE_GEOMETRY_AVX2
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+__attribute__((target("avx2")))
+bool orientAvx2(const Point& a, const Point& b, const double* xs, const double* ys, size_t n, double* out) {
+    const __m256d ax = _mm256_set1_pd(a.x), ay = _mm256_set1_pd(a.y);
+    const __m256d bx = _mm256_set1_pd(b.x), by = _mm256_set1_pd(b.y);
+    const __m256d bound = _mm256_set1_pd(CcwErrBound);
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256d uncertain = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_load_pd(xs + i);
+        __m256d y = _mm256_load_pd(ys + i);
+        __m256d left = _mm256_mul_pd(_mm256_sub_pd(ax, x), _mm256_sub_pd(by, y));
+        __m256d right = _mm256_mul_pd(_mm256_sub_pd(ay, y), _mm256_sub_pd(bx, x));
+        __m256d det = _mm256_sub_pd(left, right);
+        _mm256_storeu_pd(out + i, det);
+        __m256d err = _mm256_mul_pd(bound, _mm256_add_pd(_mm256_and_pd(left, absMask),
+                                                         _mm256_and_pd(right, absMask)));
+        uncertain = _mm256_or_pd(uncertain, _mm256_cmp_pd(_mm256_and_pd(det, absMask), err, _CMP_LE_OQ));
+    }
+    bool certain = _mm256_movemask_pd(uncertain) == 0;
+    return orientScalar(a, b, xs, ys, i, n, out) && certain;
+}
+
+#endif
+
+} // namespace
+
+void orient2d(const Point& a, const Point& b, const PointSet& pts, double* out) {
+    const size_t n = pts.size();
+    bool certain;
+#ifdef PLANE_GEOMETRY_AVX2
+    if (hasAvx2()) certain = orientAvx2(a, b, pts.xs(), pts.ys(), n, out);
+    else
+#endif
+    certain = orientScalar(a, b, pts.xs(), pts.ys(), 0, n, out);
+    if (certain) return;
+
+    // Редкий случай: точки почти на прямой ab
+    for (size_t i = 0; i < n; ++i) {
+        double left = (a.x - pts.xs()[i]) * (b.y - pts.ys()[i]);
+        double right = (a.y - pts.ys()[i]) * (b.x - pts.xs()[i]);
+        if (!(std::fabs(out[i]) > CcwErrBound * (std::fabs(left) + std::fabs(right))))
+            out[i] = orient2d(a, b, pts.point(i));
+    }
+}
+
+}
@@ -0,0 +1,149 @@
+#include "PlaneGeometry/Predicates.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace PlaneGeometry {
+
+namespace {
+
+// Точная арифметика разложений: число хранится как сумма неперекрывающихся
+// компонент по возрастанию модуля, знак суммы равен знаку старшей компоненты
+using Expansion = std::vector<double>;
+
+constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;   // 2^-53
+constexpr double CcwErrBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+constexpr double IccErrBound = (10.0 + 96.0 * Epsilon) * Epsilon;
+
+void twoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void twoProduct(double a, double b, double& x, double& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// e + b с удалением нулевых компонент
+Expansion grow(const Expansion& e, double b) {
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double component : e) {
+        double sum, err;
+        twoSum(q, component, sum, err);
+        if (err != 0) h.push_back(err);
+        q = sum;
+    }
+    if (q != 0 || h.empty()) h.push_back(q);
+    return h;
+}
+
+Expansion add(Expansion e, const Expansion& f) {
+    for (double component : f) e = grow(e, component);
+    return e;
+}
+
+Expansion negate(Expansion e) {
+    for (double& component : e) component = -component;
+    return e;
+}
+
+Expansion multiply(const Expansion& e, const Expansion& f) {
+    Expansion result{0.0};
+    for (double a : e) {
+        for (double b : f) {
+            double x, y;
+            twoProduct(a, b, x, y);
+            result = grow(result, y);
+            result = grow(result, x);
+        }
+    }
+    return result;
+}
+
+Expansion difference(double a, double b) {
+    double x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    double y = (a - av) + (bv - b);
+    return grow(Expansion{y}, x);
+}
+
+double estimate(const Expansion& e) {
+    return e.back();
+}
+
+double orient2dExact(const Point& a, const Point& b, const Point& c) {
+    Expansion acx = difference(a.x, c.x), acy = difference(a.y, c.y);
+    Expansion bcx = difference(b.x, c.x), bcy = difference(b.y, c.y);
+    return estimate(add(multiply(acx, bcy), negate(multiply(acy, bcx))));
+}
+
+double incircleExact(const Point& a, const Point& b, const Point& c, const Point& d) {
+    Expansion adx = difference(a.x, d.x), ady = difference(a.y, d.y);
+    Expansion bdx = difference(b.x, d.x), bdy = difference(b.y, d.y);
+    Expansion cdx = difference(c.x, d.x), cdy = difference(c.y, d.y);
+
+    Expansion alift = add(multiply(adx, adx), multiply(ady, ady));
+    Expansion blift = add(multiply(bdx, bdx), multiply(bdy, bdy));
+    Expansion clift = add(multiply(cdx, cdx), multiply(cdy, cdy));
+
+    Expansion bc = add(multiply(bdx, cdy), negate(multiply(cdx, bdy)));
+    Expansion ca = add(multiply(cdx, ady), negate(multiply(adx, cdy)));
+    Expansion ab = add(multiply(adx, bdy), negate(multiply(bdx, ady)));
+
+    return estimate(add(add(multiply(alift, bc), multiply(blift, ca)), multiply(clift, ab)));
+}
+
+} // namespace
+
+double orient2d(const Point& a, const Point& b, const Point& c) {
+    double detleft  = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright;
+
+    double detsum;
+    if (detleft > 0) {
+        if (detright <= 0) return det;
+        detsum = detleft + detright;
+    } else if (detleft < 0) {
+        if (detright >= 0) return det;
+        detsum = -detleft - detright;
+    } else {
+        return det;
+    }
+
+    double errbound = CcwErrBound * detsum;
+    if (det >= errbound || -det >= errbound) return det;
+    return orient2dExact(a, b, c);
+}
+
+double incircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+    double adx = a.x - d.x, ady = a.y - d.y;
+    double bdx = b.x - d.x, bdy = b.y - d.y;
+    double cdx = c.x - d.x, cdy = c.y - d.y;
+
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+
+    double det = alift * (bdxcdy - cdxbdy)
+               + blift * (cdxady - adxcdy)
+               + clift * (adxbdy - bdxady);
+
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                     + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                     + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    double errbound = IccErrBound * permanent;
+    if (det > errbound || -det > errbound) return det;
+    return incircleExact(a, b, c, d);
+}
+
+}
@@ -0,0 +1,303 @@
+#include "PlaneGeometry/RadixSort.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace PlaneGeometry {
+
+namespace {
+
+// Разряды по 16 бит: четыре прохода на 64-битный ключ. Меньшие наборы
+// быстрее сортируются сравнениями, чем окупаются таблицы на 2^16 корзин
+constexpr int DigitBits = 16;
+constexpr int Digits = 64 / DigitBits;
+constexpr size_t Buckets = size_t(1) << DigitBits;
+constexpr size_t RadixMinPoints = 1 << 16;
+// Кусок одного потока при параллельных проходах
+constexpr size_t ParallelMinChunk = 1 << 18;
+
+// Раскладка по значению координаты: не больше SplitBuckets корзин, в среднем
+// BucketPoints точек на корзину. Корзина до FineMaxPoints точек (лежит в кэше)
+// сразу раскладывается второй раз - по точке на корзину, остальные
+// сортируются тем же способом заново. Серии до SmallRun точек досортировываются
+// вставками; после MaxSplitDepth раскладок подряд (сильно неравномерные
+// данные) набор досортировывается поразрядно
+constexpr size_t SplitBuckets = size_t(1) << 16;
+constexpr size_t BucketPoints = 8;
+constexpr size_t FineMaxPoints = 1 << 12;
+constexpr size_t SmallRun = 16;
+constexpr int MaxSplitDepth = 3;
+
+using Histogram = std::vector<std::uint32_t>;
+
+bool lessXY(const Point& a, const Point& b) {
+    if (a.x == b.x) return a.y < b.y;
+    return a.x < b.x;
+}
+
+
+// На время проходов вместо x хранится его ключ (те же 8 байт)
+inline std::uint64_t keyOf(const Point& p) {
+    std::uint64_t key;
+    std::memcpy(&key, &p.x, sizeof key);
+    return key;
+}
+
+inline size_t digitOf(const Point& p, int digit) {
+    return (keyOf(p) >> (digit * DigitBits)) & (Buckets - 1);
+}
+
+inline double valueOf(std::uint64_t key) {
+    std::uint64_t bits = (key >> 63) ? key & ~(std::uint64_t(1) << 63) : ~key;
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+// Выполняет f(c, begin, end) для кусков [0, n) в chunks потоках
+template <class F>
+void forEachChunk(size_t n, size_t chunks, F f) {
+    if (chunks == 1) {
+        f(0, 0, n);
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    for (size_t c = 0; c < chunks; ++c)
+        tasks.push_back(std::async(std::launch::async, f, c, n * c / chunks, n * (c + 1) / chunks));
+    for (auto& task : tasks) task.get();
+}
+
+// Возвращает x на место ключа и досортировывает серии с равным x по y
+void restoreAndSortRuns(Point* pts, size_t n) {
+    for (size_t i = 0; i < n; ) {
+        const std::uint64_t key = keyOf(pts[i]);
+        size_t j = i + 1;
+        while (j < n && keyOf(pts[j]) == key) ++j;
+        const double x = valueOf(key);
+        for (size_t k = i; k < j; ++k) pts[k].x = x;
+        if (j - i > 1)
+            std::sort(pts + i, pts + j, [](const Point& a, const Point& b) { return a.y < b.y; });
+        i = j;
+    }
+}
+
+// Поразрядная сортировка по ключу x с досортировкой серий по y: число
+// проходов не зависит от распределения точек
+void radixSortByXY(Point* pts, size_t n, unsigned threads) {
+    if (n < RadixMinPoints) {
+        std::sort(pts, pts + n, lessXY);
+        return;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, n / ParallelMinChunk));
+
+    // Гистограммы всех разрядов за один проход, по куску на поток;
+    // заодно x заменяется ключом
+    std::vector<Histogram> counts(chunks, Histogram(Digits * Buckets, 0));
+    forEachChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+        std::uint32_t* count = counts[c].data();
+        for (size_t i = begin; i < end; ++i) {
+            std::uint64_t key = orderedKey(pts[i].x);
+            std::memcpy(&pts[i].x, &key, sizeof key);
+            for (int d = 0; d < Digits; ++d) ++count[d * Buckets + ((key >> (d * DigitBits)) & (Buckets - 1))];
+        }
+    });
+
+    std::unique_ptr<Point[]> buffer(new Point[n]);
+    Point* from = pts;
+    Point* to = buffer.get();
+    bool permuted = false;
+    for (int d = 0; d < Digits; ++d) {
+        // Разряд, одинаковый у всех точек, порядок не меняет
+        size_t total = 0;
+        for (size_t c = 0; c < chunks; ++c) total += counts[c][d * Buckets + digitOf(from[0], d)];
+        if (total == n) continue;
+
+        // Частоты разряда по кускам текущего порядка: после первого прохода
+        // куски состоят уже из других точек, и их приходится пересчитать
+        if (chunks > 1 && permuted) {
+            forEachChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+                std::uint32_t* count = counts[c].data() + d * Buckets;
+                std::fill(count, count + Buckets, 0);
+                for (size_t i = begin; i < end; ++i) ++count[digitOf(from[i], d)];
+            });
+        }
+
+        // Начало корзины каждого куска: корзины по порядку, внутри корзины -
+        // куски по порядку, так что проход устойчив
+        std::uint32_t offset = 0;
+        for (size_t b = 0; b < Buckets; ++b) {
+            for (size_t c = 0; c < chunks; ++c) {
+                std::uint32_t& count = counts[c][d * Buckets + b];
+                std::uint32_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+        }
+
+        forEachChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+            std::uint32_t* next = counts[c].data() + d * Buckets;
+            for (size_t i = begin; i < end; ++i) to[next[digitOf(from[i], d)]++] = from[i];
+        });
+        std::swap(from, to);
+        permuted = true;
+    }
+    if (from != pts) std::copy(from, from + n, pts);
+
+    restoreAndSortRuns(pts, n);
+}
+
+void insertionSort(Point* pts, size_t n) {
+    for (size_t i = 1; i < n; ++i) {
+        const Point p = pts[i];
+        size_t j = i;
+        for (; j > 0 && lessXY(p, pts[j - 1]); --j) pts[j] = pts[j - 1];
+        pts[j] = p;
+    }
+}
+
+// Номер корзины - целая часть (v - lo) * scale. Вычитание и умножение на
+// положительное число в double сохраняют порядок, поэтому номера монотонны
+// по значению, а равные значения попадают в одну корзину
+struct Split {
+    double lo;
+    double scale;
+    size_t last;
+
+    double position(double v) const { return (v - lo) * scale; }
+    size_t operator()(double v) const { return std::min(size_t(position(v)), last); }
+};
+
+void splitSort(Point* pts, size_t n, Point* buffer, double Point::*coord, int depth, size_t chunks = 1);
+
+// Сортирует серию pts[0..n) с уже упорядоченными соседями, buffer - рабочее место
+void sortRun(Point* pts, size_t n, Point* buffer, double Point::*coord, int depth) {
+    if (n <= SmallRun) insertionSort(pts, n);
+    else splitSort(pts, n, buffer, coord, depth + 1);
+}
+
+// Раскладывает корзину bucket (from[0..n), значения coord в ней - от
+// bucket до bucket + 1 в единицах split) второй раз в to[0..n) - примерно
+// по точке на корзину - и досортировывает серии
+void fineSort(const Point* from, Point* to, size_t n, const Split& split, size_t bucket,
+              Point* buffer, double Point::*coord, int depth) {
+    std::uint32_t next[FineMaxPoints + 1] = {};
+    const double base = double(bucket);
+    const double scale = double(n);
+    auto fine = [&](const Point& p) {
+        return std::min(size_t((split.position(p.*coord) - base) * scale), n - 1);
+    };
+    for (size_t i = 0; i < n; ++i) ++next[fine(from[i]) + 1];
+    for (size_t b = 0; b < n; ++b) next[b + 1] += next[b];
+    for (size_t i = 0; i < n; ++i) to[next[fine(from[i])]++] = from[i];
+
+    for (size_t b = 0, first = 0; b < n; first = next[b++]) {
+        if (next[b] - first > 1) sortRun(to + first, next[b] - first, buffer + first, coord, depth);
+    }
+}
+
+// Сортирует pts[0..n), buffer - рабочее место на n точек. Точки
+// раскладываются по корзинам значения coord; серия, где все значения
+// x совпали, раскладывается дальше по y. Проходы по точкам и корзинам
+// делятся на chunks потоков
+void splitSort(Point* pts, size_t n, Point* buffer, double Point::*coord, int depth, size_t chunks) {
+    if (n <= SmallRun) {
+        insertionSort(pts, n);
+        return;
+    }
+
+    // Границы значений; v - v != 0 только у бесконечностей и NaN
+    struct Range {
+        double lo, hi;
+        bool finite;
+    };
+    std::vector<Range> ranges(chunks);
+    forEachChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+        Range r{pts[begin].*coord, pts[begin].*coord, true};
+        for (size_t i = begin; i < end; ++i) {
+            const double v = pts[i].*coord;
+            r.lo = std::min(r.lo, v);
+            r.hi = std::max(r.hi, v);
+            r.finite &= v - v == 0;
+        }
+        ranges[c] = r;
+    });
+    Range range = ranges[0];
+    for (const Range& r : ranges) {
+        range.lo = std::min(range.lo, r.lo);
+        range.hi = std::max(range.hi, r.hi);
+        range.finite &= r.finite;
+    }
+    if (range.finite && range.lo == range.hi) {
+        if (coord == &Point::x) splitSort(pts, n, buffer, &Point::y, 0, chunks);
+        return;
+    }
+
+    const size_t buckets = std::clamp<size_t>(n / BucketPoints, 2, SplitBuckets);
+    const Split split{range.lo, double(buckets) / (range.hi - range.lo), buckets - 1};
+    if (!range.finite || depth >= MaxSplitDepth || !std::isfinite(split.scale) ||
+        !std::isfinite(range.hi - range.lo)) {
+        if (coord == &Point::x) radixSortByXY(pts, n, unsigned(chunks));
+        else std::sort(pts, pts + n, lessXY);
+        return;
+    }
+
+    // Устойчивая раскладка в buffer: корзины по порядку, внутри корзины -
+    // куски по порядку
+    std::vector<Histogram> counts(chunks, Histogram(buckets, 0));
+    forEachChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+        std::uint32_t* count = counts[c].data();
+        for (size_t i = begin; i < end; ++i) ++count[split(pts[i].*coord)];
+    });
+    Histogram begin(buckets + 1);
+    std::uint32_t offset = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        begin[b] = offset;
+        for (size_t c = 0; c < chunks; ++c) {
+            std::uint32_t bucketSize = counts[c][b];
+            counts[c][b] = offset;
+            offset += bucketSize;
+        }
+    }
+    begin[buckets] = offset;
+    forEachChunk(n, chunks, [&](size_t c, size_t first, size_t end) {
+        std::uint32_t* next = counts[c].data();
+        for (size_t i = first; i < end; ++i) buffer[next[split(pts[i].*coord)]++] = pts[i];
+    });
+
+    // Корзины возвращаются из buffer в pts: мелкие - второй раскладкой,
+    // крупные - копией и сортировкой на месте. Поток берет корзины
+    // с точками из своей доли [0, n)
+    forEachChunk(n, chunks, [&](size_t, size_t first, size_t end) {
+        size_t b = std::lower_bound(begin.begin(), begin.end() - 1, std::uint32_t(first)) - begin.begin();
+        for (; b < buckets && begin[b] < end; ++b) {
+            const size_t from = begin[b], count = begin[b + 1] - from;
+            if (count <= FineMaxPoints) {
+                fineSort(buffer + from, pts + from, count, split, b, buffer + from, coord, depth);
+            } else {
+                std::copy(buffer + from, buffer + begin[b + 1], pts + from);
+                splitSort(pts + from, count, buffer + from, coord, depth + 1);
+            }
+        }
+    });
+}
+
+} // namespace
+
+void sortByXY(Point* pts, size_t n, unsigned threads) {
+    if (n < RadixMinPoints) {
+        std::sort(pts, pts + n, lessXY);
+        return;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, n / ParallelMinChunk));
+
+    std::unique_ptr<Point[]> buffer(new Point[n]);
+    splitSort(pts, n, buffer.get(), &Point::x, 0, chunks);
+}
+
+}
@@ -0,0 +1,111 @@
+#include "PlaneGeometry/StreamingHull.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace PlaneGeometry {
+
+namespace {
+
+constexpr size_t FirstFlushPoints = 1024;
+constexpr size_t AddBlock = 1024;
+// Оценка погрешности векторного произведения с запасом, как у отсечения в convexHull
+constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;
+constexpr double ErrBound = 2 * (3.0 + 16.0 * Epsilon) * Epsilon;
+
+}
+
+StreamingHull::StreamingHull(const HullOptions& options, size_t bufferPoints)
+    : m_options(options), m_bufferPoints(std::max<size_t>(bufferPoints, 1)),
+      m_flushAt(std::min(m_bufferPoints, FirstFlushPoints)) {
+    m_buffer.reserve(m_bufferPoints);
+}
+
+double StreamingHull::margin(const Point& p) const {
+    double least = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < 8; ++k) {
+        double t1 = m_dx[k] * (p.y - m_ay[k]);
+        double t2 = m_dy[k] * (p.x - m_ax[k]);
+        least = std::min(least, t1 - t2 - ErrBound * (std::fabs(t1) + std::fabs(t2)));
+    }
+    return least;
+}
+
+void StreamingHull::add(const Point& p) {
+    add(&p, 1);
+}
+
+void StreamingHull::add(const Point* pts, size_t n) {
+    // Запасы считаются блоком без ветвлений (цикл векторизуется); слияние
+    // посреди блока только расширяет оболочку, так что старые запасы верны
+    double margins[AddBlock];
+    for (size_t begin = 0; begin < n; begin += AddBlock) {
+        const size_t count = std::min(AddBlock, n - begin);
+        const Point* block = pts + begin;
+        if (m_octagonReady) {
+            for (size_t i = 0; i < count; ++i) margins[i] = margin(block[i]);
+        } else {
+            std::fill(margins, margins + count, 0.0);
+        }
+
+        m_seen += count;
+        for (size_t i = 0; i < count; ++i) {
+            if (margins[i] > 0) {
+                ++m_rejected;
+                continue;
+            }
+            m_buffer.push_back(block[i]);
+            if (m_buffer.size() >= std::max(m_flushAt, m_hull.size())) flush();
+        }
+    }
+}
+
+const Polygon& StreamingHull::hull() {
+    if (!m_buffer.empty()) flush();
+    return m_hull;
+}
+
+void StreamingHull::flush() {
+    m_buffer.insert(m_buffer.end(), m_hull.begin(), m_hull.end());
+    m_hull = convexHull(m_buffer, m_options);
+    m_buffer.clear();
+    m_flushAt = std::min(m_bufferPoints, 2 * m_flushAt);
+
+    // Восьмиугольник из крайних вершин по x, y, x+y и x-y против часовой:
+    // min x, min x+y, min y, max x-y, max x, max x+y, max y, min x-y
+    m_octagonReady = false;
+    if (m_hull.size() < 3) return;
+    size_t ext[8] = {};
+    for (size_t i = 1; i < m_hull.size(); ++i) {
+        const Point& p = m_hull[i];
+        auto at = [&](int k) -> const Point& { return m_hull[ext[k]]; };
+        if (p.x < at(0).x) ext[0] = i;
+        if (p.x + p.y < at(1).x + at(1).y) ext[1] = i;
+        if (p.y < at(2).y) ext[2] = i;
+        if (p.x - p.y > at(3).x - at(3).y) ext[3] = i;
+        if (p.x > at(4).x) ext[4] = i;
+        if (p.x + p.y > at(5).x + at(5).y) ext[5] = i;
+        if (p.y > at(6).y) ext[6] = i;
+        if (p.x - p.y < at(7).x - at(7).y) ext[7] = i;
+    }
+    Point octagon[8];
+    size_t m = 0;
+    for (int k = 0; k < 8; ++k) {
+        const Point& p = m_hull[ext[k]];
+        if (m == 0 || p.x != octagon[m-1].x || p.y != octagon[m-1].y) octagon[m++] = p;
+    }
+    while (m > 1 && octagon[m-1].x == octagon[0].x && octagon[m-1].y == octagon[0].y) --m;
+    if (m < 3) return;
+
+    // Недостающие до восьми ребра повторяют последнее
+    for (size_t k = 0; k < 8; ++k) {
+        size_t j = std::min(k, m - 1);
+        m_ax[k] = octagon[j].x;
+        m_ay[k] = octagon[j].y;
+        m_dx[k] = octagon[(j+1) % m].x - octagon[j].x;
+        m_dy[k] = octagon[(j+1) % m].y - octagon[j].y;
+    }
+    m_octagonReady = true;
+}
+
+}
@@ -106,8 +106,7 @@ void CanvasWidget::recomputeResult() {
     case Op::Difference: {            //  A\B
         const Polygon& Left  = m_diffBA ? m_hullB : m_hullA;
         const Polygon& Right = m_diffBA ? m_hullA : m_hullB;
-        Polygon D = PlaneGeometry::differenceConvex(Left, Right);
-        if (!D.empty()) m_result.push_back(std::move(D));
+        m_result = PlaneGeometry::differenceConvexDecomposed(Left, Right);
         m_intersection = PlaneGeometry::intersectConvex(Left, Right);
     } break;
 